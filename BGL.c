@@ -5,19 +5,34 @@
     -------------------------
     Server-side garage/storage controller attached to a world entity (e.g., garage sign).
     Handles:
-      - Persisting per-player vehicle data to the profile directory
+      - Persisting per-player vehicle data (through the shared BGL_GarageCache)
       - Storing a nearby vehicle (with safety checks: radius, empty seats, no weapons)
       - Spawning a stored vehicle at a configured PointInfo
       - Managing vehicle keys (ID/CODE) and item inventories
       - Enforcing per-player vehicle limits
+      - Pooled faction/group garages next to personal ones (BGL_GaragePools),
+        with per-vehicle checkout locks (BGL_GarageCheckout)
+      - Bulk operations: StoreAll() (every keyed vehicle in range, one cache
+        write) and WithdrawConvoy() (several vehicles over the spawn pads),
+        each answered with one summary notification
 
     Files:
-      - Saved under $profile:BLG/<playerUid>.json
+      - Saved under $profile:BLG/<shard>/<playerUid>.json by BGL_GarageCache (write-back,
+        written a few per frame by BGL_GarageWriter with an atomic replace),
+        or <playerUid>.bglb when m_bBinaryStorage is set (BGL_GarageBinaryCodec)
+      - $profile:BLG/index.json: per-player vehicle counts (BGL_GarageIndex)
+      - With m_eStorageBackend = REST the garages are shared between servers
+        through a REST service (BGL_RestStorageBackend); the files above are
+        the local read-through cache, synced in the background
 
     Key Concepts:
-      - Storage payload: BGL_PlayerGarageStorageEntity { player_uid, vehicles[] }
-      - Vehicle entry: BGL_VehicleStorageEntity { prefab, key_id, key_code, items... }
-      - Nearby queries: sphere search around the owning entity (for store) or spawn point (for load)
+      - Storage payload: BGL_PlayerGarageStorageEntity { player_uid, vehicles[] },
+        one per garage key (player UID, or pool_faction_<key> / pool_group_<id>)
+      - Vehicle entry: BGL_VehicleStorageEntity { id, prefab, key_id, key_code, items, state }
+      - Keyed vehicle lookup: BGL_VehicleKeyRegistry (key id → live vehicle) + distance check,
+        ranked nearest-first to the sign or spawn point (for store; see BGL_VehicleCandidate)
+      - Nearby queries: sphere search around each spawn pad (for load); the first
+        clear pad is used, otherwise the withdrawal waits in a FIFO queue
       - Key validation: Only vehicles matching a player's key(s) may be stored
 
     Assumptions:
@@ -29,6 +44,16 @@
       - UI hints/notifications are dispatched via SCR_PlayerController.BGL_Server_RequestNotify.
 */
 
+//! Outcome of storing one candidate vehicle (see BGL_Component.TryStoreCandidate).
+enum EBGL_StoreResult
+{
+	STORED,
+	OCCUPIED,
+	WEAPONS,
+	GARAGE_FULL,
+	FAILED
+}
+
 class BGL_ComponentClass: ScriptComponentClass {}
 
 class BGL_Component : ScriptComponent
@@ -40,20 +65,76 @@ class BGL_Component : ScriptComponent
 	[Attribute()]
 	ref PointInfo m_SpawnPosition;           //!< Optional spawn transform anchor for LoadCar()
 
+	[Attribute(desc: "Additional spawn pads; LoadCar() uses the first clear pad, starting with m_SpawnPosition (or the owner)")]
+	ref array<ref PointInfo> m_aSpawnPads;    //!< Extra withdrawal pads (pad 1..n)
+
+	[Attribute(defvalue: "3.0", desc: "Radius (meters) around a pad that must be free of vehicles before spawning on it")]
+	float m_fPadClearRadius;                  //!< Pad clearance check radius
+
 	[Attribute(defvalue: "10")]
 	int m_iMaxVehiclesPerPlayer;             //!< Per-player storage cap
 
+	[Attribute(defvalue: "0", desc: "Show the player's faction motor pool in this garage's menu")]
+	bool m_bFactionPool;                      //!< Faction pool access at this garage
+
+	[Attribute(defvalue: "0", desc: "Show the player's group (unit) motor pool in this garage's menu")]
+	bool m_bGroupPool;                        //!< Group pool access at this garage
+
+	[Attribute(defvalue: "30", desc: "Storage cap of each pooled garage")]
+	int m_iMaxVehiclesPerPool;                //!< Per-pool storage cap
+
 	[Attribute(defvalue: "10.0")]
 	float m_fRadius;                          //!< Search radius (meters) for storing vehicles
 
+	[Attribute(defvalue: "0", uiwidget: UIWidgets.ComboBox, desc: "Position keyed vehicles are ranked against when storing", enums: ParamEnumArray.FromEnum(EBGL_CandidateAnchor))]
+	EBGL_CandidateAnchor m_eCandidateAnchor;  //!< Ranking anchor for CollectCandidates()
+
+	[Attribute(defvalue: "1", desc: "Break near-ties by the vehicle this player withdrew most recently")]
+	bool m_bPreferRecentlyWithdrawn;          //!< Tie-break policy for CollectCandidates()
+
+	[Attribute(defvalue: "2.0", desc: "Distance difference (meters) treated as a tie when ranking vehicles")]
+	float m_fCandidateTieDistance;            //!< Tie window for CollectCandidates()
+
+	[Attribute(defvalue: "0", desc: "Persist store/withdraw/delete as append-only journal records (server-wide)")]
+	bool m_bJournalPersistence;               //!< Enables BGL_GarageJournal in BGL_GarageCache
+
+	[Attribute(defvalue: "0", desc: "Save player garages in the compact binary format instead of JSON (server-wide; existing files migrate on next write)")]
+	bool m_bBinaryStorage;                    //!< Enables BGL_GarageBinaryCodec in BGL_GarageCache
+
+	[Attribute(defvalue: "0", uiwidget: UIWidgets.ComboBox, desc: "Where garages are stored: local files, or a REST service shared between servers with the local files as cache (server-wide)", enums: ParamEnumArray.FromEnum(EBGL_StorageBackend))]
+	EBGL_StorageBackend m_eStorageBackend;    //!< Storage backend for BGL_GarageCache
+
+	[Attribute(desc: "Base URL of the REST garage service (REST backend), e.g. http://127.0.0.1:8080/bgl/")]
+	string m_sBackendUrl;                     //!< BGL_RestStorageBackend base URL
+
+	[Attribute(desc: "Bearer token sent to the REST garage service (optional)")]
+	string m_sBackendToken;                   //!< BGL_RestStorageBackend auth token
+
+	[Attribute(defvalue: "10", desc: "Max inventory items deleted/spawned per frame while rehydrating withdrawn vehicles")]
+	int m_iRehydrateItemsPerTick;             //!< Rehydration item budget per frame
+
+	[Attribute(defvalue: "2.0", desc: "Max milliseconds per frame spent rehydrating withdrawn vehicles")]
+	float m_fRehydrateBudgetMs;               //!< Rehydration time budget per frame
+
+	[Attribute(defvalue: "2", desc: "Max vehicles spawned per frame across all garages (server-wide withdrawal queue)")]
+	int m_iWithdrawalsPerFrame;               //!< BGL_WithdrawalQueue spawn budget
+
+	[Attribute(defvalue: "0", desc: "Collect store/withdraw phase timings and RPC payload sizes (server-wide, see BGL_Metrics)")]
+	bool m_bMetrics;                          //!< Enables BGL_Metrics
+
+	[Attribute(defvalue: "60", desc: "Seconds between metric dumps to $profile:BLG/metrics.prom")]
+	int m_iMetricsDumpIntervalS;              //!< BGL_Metrics dump interval
+
 	// -----------------------------
 	// Internals
 	// -----------------------------
 
-	protected const string DATA_DIR = "$profile:BLG/"; //!< Save directory
+	static const ResourceName CAR_KEY_PREFAB = "{CCFD8AA837B9611A}Prefabs/Items/CarKey/CarKey.et"; //!< Key item prefab
+
 	protected IEntity m_FoundEntity;                   //!< Temp: query result
-	protected array<string> m_keyIds;                  //!< Temp: keys found in player inventory
-	protected string m_foundKey;                       //!< Temp: matched key id used for store
+	protected ref set<string> m_MissedKeyIds;          //!< Temp: held key ids without a registered vehicle (fallback query)
+	protected ref array<IEntity> m_aFallbackVehicles;  //!< Temp: fallback query result
+	protected ref array<ref BGL_RehydrationJob> m_aRehydrationJobs = {}; //!< Withdrawn vehicles still being populated
 
 	// =========================================================
 	// Lifecycle
@@ -61,19 +142,56 @@ class BGL_Component : ScriptComponent
 
 	/*!
 	    Component post-init.
-	    - Ensures save directory exists
 	    - Activates owner and hooks INIT
+	    - Enables journal persistence / the REST storage backend on the shared cache if configured
+	    - Starts BGL_GarageMaintenance / BGL_Benchmark when launched with
+	      -bglMaintenance / -bglBenchmark
+	    (Save directory is created by BGL_GarageCache on first use.)
 	*/
 	override void OnPostInit(IEntity owner)
 	{
 		super.OnPostInit(owner);
 
-		FileIO.MakeDirectory(DATA_DIR);
+		if (m_bJournalPersistence && Replication.IsServer())
+			BGL_GarageCache.GetInstance().SetJournalMode(true);
+
+		if (m_bBinaryStorage && Replication.IsServer())
+			BGL_GarageCache.GetInstance().SetBinaryMode(true);
+
+		if (m_eStorageBackend == EBGL_StorageBackend.REST && Replication.IsServer())
+			BGL_GarageCache.GetInstance().SetBackend(new BGL_RestStorageBackend(m_sBackendUrl, m_sBackendToken));
+
+		if (m_bMetrics && Replication.IsServer())
+			BGL_Metrics.Enable(m_iMetricsDumpIntervalS);
+
+		if (Replication.IsServer())
+			BGL_WithdrawalQueue.GetInstance().SetSpawnsPerFrame(m_iWithdrawalsPerFrame);
+
+		if (Replication.IsServer())
+		{
+			BGL_GarageMaintenance.StartFromCLI();
+			BGL_Benchmark.StartFromCLI();
+		}
 
 		SetEventMask(owner, EntityEvent.INIT);
 		owner.SetFlags(EntityFlags.ACTIVE, true);
 	}
 
+	/*!
+	    Component teardown.
+	    - Flushes every dirty cached garage and waits for queued writes (shutdown barrier)
+	*/
+	override void OnDelete(IEntity owner)
+	{
+		GetGame().GetCallqueue().Remove(TickRehydration);
+		BGL_WithdrawalQueue.GetInstance().RemoveGarage(this);
+
+		if (Replication.IsServer())
+			BGL_GarageCache.GetInstance().FlushAll();
+
+		super.OnDelete(owner);
+	}
+
 	// =========================================================
 	// Public API
 	// =========================================================
@@ -91,279 +209,820 @@ class BGL_Component : ScriptComponent
 
 	/*!
 	    Attempt to store the nearest eligible vehicle for the player.
-	    Flow:
-	      1) Read player's inventory keys → m_keyIds
-	      2) Find nearest vehicle within m_fRadius that matches a key
-	      3) Validate: no occupied seats, no weapons in vehicle storage, capacity not exceeded
-	      4) Capture vehicle state (prefab, inventory → itemsMap, key id/code)
-	      5) Save to player's storage file
-	      6) Delete world vehicle and (optionally) remove matching key from player inventory
+	    Equivalent to StoreNearest(garageKey, playerId, 1) on the garage of
+	    the given scope (personal, or the player's faction/group pool).
 
-	    Notifications:
+	    \param playerUid Persistent player UID
+	    \param playerId  Runtime player ID (for controller + notifications)
+	    \param scope     Garage to store into
+	    \return true if stored successfully, false otherwise
+	*/
+	bool Store(string playerUid, int playerId, EBGL_GarageScope scope = EBGL_GarageScope.PERSONAL)
+	{
+		string garageKey = BGL_GaragePools.GetGarageKey(scope, playerId, playerUid);
+		if (garageKey.IsEmpty())
+		{
+			SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (playerController)
+				playerController.BGL_Server_RequestNotify("Garage", "You have no motor pool to store into.");
+
+			return false;
+		}
+
+		return StoreNearest(garageKey, playerId, 1) > 0;
+	}
+
+	/*!
+	    Garage keys the player can open at this garage: their personal garage,
+	    then the faction and group pools enabled on this component.
+	*/
+	void GetAccessibleGarages(int playerId, string playerUid, notnull array<string> outKeys)
+	{
+		outKeys.Insert(playerUid);
+
+		if (m_bFactionPool)
+		{
+			string factionKey = BGL_GaragePools.GetGarageKey(EBGL_GarageScope.FACTION, playerId, playerUid);
+			if (!factionKey.IsEmpty())
+				outKeys.Insert(factionKey);
+		}
+
+		if (m_bGroupPool)
+		{
+			string groupKey = BGL_GaragePools.GetGarageKey(EBGL_GarageScope.GROUP, playerId, playerUid);
+			if (!groupKey.IsEmpty())
+				outKeys.Insert(groupKey);
+		}
+	}
+
+	/*!
+	    True if the player may use garageKey at this garage (server-side check
+	    for client requests).
+	*/
+	bool CanAccessGarage(int playerId, string playerUid, string garageKey)
+	{
+		array<string> keys = {};
+		GetAccessibleGarages(playerId, playerUid, keys);
+		return keys.Contains(garageKey);
+	}
+
+	/*!
+	    Store up to maxCount of the player's keyed vehicles, best-ranked first.
+	    Flow:
+	      1) Index player's inventory keys in one pass → BGL_KeyIndex
+	      2) Gather every keyed vehicle within m_fRadius (BGL_VehicleKeyRegistry)
+	         and rank them (CollectCandidates)
+	      3) For each of the first maxCount candidates (TryStoreCandidate):
+	         validate (no occupied seats, no weapons in vehicle storage, capacity),
+	         capture state and the inventory tree (BGL_InventorySnapshot),
+	         append to storage, delete the world vehicle and the
+	         matching key from the player inventory
+
+	    Notifications (per attempted candidate):
+	      - "Garage is syncing, try again in a moment." (storage backend fetch in flight)
 	      - "Your vehicle is not within the storage radius"
 	      - "Weapons in compartment, please remove before storage."
 	      - "Garage is full, can't store more vehicles."
 	      - "Your vehicle has been stored."
 
-	    \param playerUid Persistent player UID
+	    \param garageKey Garage to store into (player UID or pool key)
 	    \param playerId  Runtime player ID (for controller + notifications)
-	    \return true if stored successfully, false otherwise
+	    \param maxCount  Number of ranked candidates to attempt
+	    \return Number of vehicles stored
 	*/
-	bool Store(string playerUid, int playerId)
+	int StoreNearest(string garageKey, int playerId, int maxCount)
 	{
 		IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
 		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+		if (!BGL_GaragePools.IsPool(garageKey))
+			BGL_GarageCache.GetInstance().BindPlayer(playerId, garageKey);
 
-		// 1) Gather player-held car keys
+		if (BGL_GarageCache.GetInstance().IsSyncing(garageKey))
+		{
+			BGL_Metrics.Count("store_syncing_total");
+			playerController.BGL_Server_RequestNotify("Garage", "Garage is syncing, try again in a moment.");
+			return 0;
+		}
+
+		// 1) Index player-held car keys (key id → item)
+		int tick = System.GetTickCount();
 		InventoryStorageManagerComponent playerInv = InventoryStorageManagerComponent.Cast(player.FindComponent(InventoryStorageManagerComponent));
-		array<string> keyIds = {};
 		array<IEntity> playerInvItems = {};
 		playerInv.GetItems(playerInvItems);
 
-		foreach (IEntity item : playerInvItems)
-		{
-			string prefabName = item.GetPrefabData().GetPrefabName();
-			if (prefabName == "{CCFD8AA837B9611A}Prefabs/Items/CarKey/CarKey.et")
-			{
-				Key_LockComponent keyLock = Key_LockComponent.Cast(item.FindComponent(Key_LockComponent));
-				string keyId = keyLock.myID;
-				if (keyId && keyId != "")
-					keyIds.Insert(keyId);
-			}
-		}
-		m_keyIds = keyIds;
+		BGL_KeyIndex keyIndex = new BGL_KeyIndex();
+		keyIndex.Build(playerInvItems);
+		tick = BGL_Metrics.Lap("store_key_scan_ms", tick);
 
-		// 2) Find nearest keyed vehicle within radius
-		IEntity veh = FindClosestVehicle(GetOwner(), m_fRadius);
-		if (!veh)
+		// 2) Gather and rank keyed vehicles within radius
+		array<ref BGL_VehicleCandidate> candidates = {};
+		CollectCandidates(keyIndex, playerId, candidates);
+		BGL_Metrics.Lap("store_candidates_ms", tick);
+		if (candidates.IsEmpty())
 		{
+			BGL_Metrics.Count("store_no_candidate_total");
 			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle is not within the storage radius");
-			return false;
+			return 0;
 		}
 
-		// 3a) Ensure all seats/compartments are empty (no occupants)
-		SCR_BaseCompartmentManagerComponent compartmentManager = SCR_BaseCompartmentManagerComponent.Cast(veh.FindComponent(SCR_BaseCompartmentManagerComponent));
-		array<BaseCompartmentSlot> compartmentSlots = {};
-		compartmentManager.GetCompartments(compartmentSlots);
-
-		bool isOccuped = false;
-		foreach (BaseCompartmentSlot slot : compartmentSlots)
+		// 3) Attempt the best-ranked candidates
+		int stored;
+		int attempts = Math.Min(maxCount, candidates.Count());
+		for (int i; i < attempts; i++)
 		{
-			if (slot.IsOccupied())
+			EBGL_StoreResult result = TryStoreCandidate(garageKey, candidates[i], keyIndex, playerInv);
+			NotifyStoreResult(playerController, result);
+
+			if (BGL_Metrics.IsEnabled())
 			{
-				isOccuped = true;
-				break;
+				string resultName = typename.EnumToString(EBGL_StoreResult, result);
+				resultName.ToLower();
+				BGL_Metrics.Count("store_" + resultName + "_total");
 			}
+
+			if (result == EBGL_StoreResult.STORED)
+				stored++;
+			else if (result == EBGL_StoreResult.GARAGE_FULL)
+				break;
 		}
-		if (isOccuped)
+
+		return stored;
+	}
+
+	/*!
+	    Store every keyed vehicle of the player within m_fRadius in one pass
+	    (e.g. parking a convoy at the end of an op).
+
+	    Flow:
+	      1) Index keys and rank candidates once, as in StoreNearest()
+	      2) Validate and capture each candidate (CaptureCandidate), counting
+	         accepted ones against the garage cap
+	      3) Append every accepted entry with a single cache write
+	         (BGL_GarageCache.AddVehicles), then delete their world vehicles and keys
+	      4) Send one summary notification
+
+	    \param playerUid Persistent player UID
+	    \param playerId  Runtime player ID (for controller + notifications)
+	    \param scope     Garage to store into
+	    \return Number of vehicles stored
+	*/
+	int StoreAll(string playerUid, int playerId, EBGL_GarageScope scope = EBGL_GarageScope.PERSONAL)
+	{
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+		IEntity player = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
+		if (!playerController || !player)
+			return 0;
+
+		string garageKey = BGL_GaragePools.GetGarageKey(scope, playerId, playerUid);
+		if (garageKey.IsEmpty())
 		{
-			return false;
+			playerController.BGL_Server_RequestNotify("Garage", "You have no motor pool to store into.");
+			return 0;
 		}
 
-		// 3b) Ensure no weapons in vehicle storage
-		InventoryStorageManagerComponent inventory = InventoryStorageManagerComponent.Cast(veh.FindComponent(InventoryStorageManagerComponent));
-		array<IEntity> items = {};
-		inventory.GetItems(items);
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+		if (!BGL_GaragePools.IsPool(garageKey))
+			cache.BindPlayer(playerId, garageKey);
 
-		ref map<string, int> itemsMap = new map<string, int>();
-		bool haveWeapon = false;
+		if (cache.IsSyncing(garageKey))
+		{
+			BGL_Metrics.Count("store_syncing_total");
+			playerController.BGL_Server_RequestNotify("Garage", "Garage is syncing, try again in a moment.");
+			return 0;
+		}
+
+		// 1) Keys and ranked candidates
+		int tick = System.GetTickCount();
+		InventoryStorageManagerComponent playerInv = InventoryStorageManagerComponent.Cast(player.FindComponent(InventoryStorageManagerComponent));
+		array<IEntity> playerInvItems = {};
+		playerInv.GetItems(playerInvItems);
+
+		BGL_KeyIndex keyIndex = new BGL_KeyIndex();
+		keyIndex.Build(playerInvItems);
 
-		foreach (IEntity item : items)
+		array<ref BGL_VehicleCandidate> candidates = {};
+		CollectCandidates(keyIndex, playerId, candidates);
+		tick = BGL_Metrics.Lap("store_all_candidates_ms", tick);
+		if (candidates.IsEmpty())
 		{
-			if (haveWeapon) break;
+			BGL_Metrics.Count("store_no_candidate_total");
+			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle is not within the storage radius");
+			return 0;
+		}
+
+		int vehicleCount = cache.GetVehicleCount(garageKey);
+		if (vehicleCount < 0)
+			return 0;
 
-			WeaponComponent wp = WeaponComponent.Cast(item.FindComponent(WeaponComponent));
-			if (wp)
+		// 2) Validate and capture
+		array<ref BGL_VehicleStorageEntity> vehicles = {};
+		array<BGL_VehicleCandidate> accepted = {};
+		array<int> refused = {0, 0, 0, 0, 0}; // count per EBGL_StoreResult
+		foreach (BGL_VehicleCandidate candidate : candidates)
+		{
+			BGL_VehicleStorageEntity vehicleData;
+			EBGL_StoreResult result = CaptureCandidate(garageKey, candidate, vehicleCount + vehicles.Count(), vehicleData);
+			if (result != EBGL_StoreResult.STORED)
 			{
-				haveWeapon = true;
-				break;
+				refused[result] = refused[result] + 1;
+				continue;
 			}
 
-			string itemName = item.GetPrefabData().GetPrefabName();
-			if (itemsMap.Contains(itemName))
-				itemsMap.Set(itemName, itemsMap.Get(itemName) + 1);
-			else
-				itemsMap.Insert(itemName, 1);
+			vehicles.Insert(vehicleData);
+			accepted.Insert(candidate);
 		}
 
-		if (haveWeapon)
+		tick = BGL_Metrics.Lap("store_all_capture_ms", tick);
+
+		// 3) One write, then remove the stored vehicles from the world
+		int added;
+		if (!vehicles.IsEmpty())
+			added = cache.AddVehicles(garageKey, vehicles);
+
+		// Vehicles the cache did not take stay in the world
+		refused[EBGL_StoreResult.FAILED] = refused[EBGL_StoreResult.FAILED] + accepted.Count() - added;
+		accepted.Resize(added);
+
+		tick = BGL_Metrics.Lap("store_all_save_ms", tick);
+
+		foreach (BGL_VehicleCandidate candidate : accepted)
 		{
-			playerController.BGL_Server_RequestNotify("Garage", "Weapons in compartment, please remove before storage.");
-			return false;
+			RemoveStoredVehicle(candidate, keyIndex, playerInv);
 		}
 
-		// 3c) Capacity check
-		Key_LockComponent keyLock = Key_LockComponent.Cast(veh.FindComponent(Key_LockComponent));
-		if (!CanStoreMoreVehicles(playerUid))
+		BGL_Metrics.Lap("store_all_delete_ms", tick);
+		BGL_Metrics.Observe("store_all_stored", accepted.Count());
+
+		// 4) Summary
+		NotifyStoreSummary(playerController, accepted.Count(), refused);
+		return accepted.Count();
+	}
+
+	/*!
+	    Validate, capture and store one candidate vehicle.
+	    \return EBGL_StoreResult describing the outcome
+	*/
+	protected EBGL_StoreResult TryStoreCandidate(string garageKey, BGL_VehicleCandidate candidate, BGL_KeyIndex keyIndex, InventoryStorageManagerComponent playerInv)
+	{
+		// Capacity is answered from the cache or the garage index
+		int vehicleCount = BGL_GarageCache.GetInstance().GetVehicleCount(garageKey);
+		if (vehicleCount < 0)
+			return EBGL_StoreResult.FAILED;
+
+		BGL_VehicleStorageEntity vehicleData;
+		EBGL_StoreResult result = CaptureCandidate(garageKey, candidate, vehicleCount, vehicleData);
+		if (result != EBGL_StoreResult.STORED)
+			return result;
+
+		// Persist (journal append, or dirty entry queued by the next flush)
+		// and only then delete the world vehicle
+		int tick = System.GetTickCount();
+		if (!BGL_GarageCache.GetInstance().AddVehicle(garageKey, vehicleData))
+			return EBGL_StoreResult.FAILED;
+
+		tick = BGL_Metrics.Lap("store_save_ms", tick);
+
+		RemoveStoredVehicle(candidate, keyIndex, playerInv);
+		BGL_Metrics.Lap("store_delete_ms", tick);
+		return EBGL_StoreResult.STORED;
+	}
+
+	/*!
+	    Validate one candidate and capture its storage entry (nothing is
+	    persisted or deleted here).
+	    \param vehicleCount     Vehicles already in the garage (including ones
+	                            accepted earlier in the same batch)
+	    \param[out] vehicleData Captured entry when the result is STORED
+	    \return EBGL_StoreResult describing the outcome
+	*/
+	protected EBGL_StoreResult CaptureCandidate(string garageKey, BGL_VehicleCandidate candidate, int vehicleCount, out BGL_VehicleStorageEntity vehicleData)
+	{
+		IEntity veh = candidate.m_Vehicle;
+		int tick = System.GetTickCount();
+
+		// a) Ensure all seats/compartments are empty (no occupants)
+		SCR_BaseCompartmentManagerComponent compartmentManager = SCR_BaseCompartmentManagerComponent.Cast(veh.FindComponent(SCR_BaseCompartmentManagerComponent));
+		array<BaseCompartmentSlot> compartmentSlots = {};
+		compartmentManager.GetCompartments(compartmentSlots);
+
+		foreach (BaseCompartmentSlot slot : compartmentSlots)
 		{
-			playerController.BGL_Server_RequestNotify("Garage", "Garage is full, can't store more vehicles.");
-			return false;
+			if (slot.IsOccupied())
+				return EBGL_StoreResult.OCCUPIED;
 		}
 
-		// 4) Capture and append to storage
-		BGL_PlayerGarageStorageEntity storage = LoadPlayerGarageData(playerUid);
-		if (!storage)
-			return false;
+		tick = BGL_Metrics.Lap("store_occupancy_ms", tick);
+
+		// b) Snapshot the inventory tree; refuse if it holds a weapon (nested included)
+		array<ref BGL_VehicleInventorySlot> inventorySlots = {};
+		if (!BGL_InventorySnapshot.Capture(veh, inventorySlots))
+			return EBGL_StoreResult.WEAPONS;
 
-		BGL_VehicleStorageEntity vehicleData = CaptureVehicleState(veh);
+		tick = BGL_Metrics.Lap("store_weapon_scan_ms", tick);
+
+		// c) Capacity check
+		if (!CanStoreMoreVehicles(garageKey, vehicleCount))
+			return EBGL_StoreResult.GARAGE_FULL;
+
+		// d) Capture state
+		vehicleData = CaptureVehicleState(veh);
 		if (!vehicleData)
-			return false;
+			return EBGL_StoreResult.FAILED;
 
-		vehicleData.FromMap(itemsMap);
+		Key_LockComponent keyLock = Key_LockComponent.Cast(veh.FindComponent(Key_LockComponent));
+		vehicleData.inventory = inventorySlots;
 		vehicleData.key_id = keyLock.myID;
 		vehicleData.key_code = keyLock.myCode;
+		BGL_Metrics.Lap("store_capture_ms", tick);
+		return EBGL_StoreResult.STORED;
+	}
 
-		storage.vehicles.Insert(vehicleData);
+	/*!
+	    Delete a stored candidate's world vehicle and the matching key from
+	    the player inventory (quality-of-life). Call only once its entry is persisted.
+	*/
+	protected void RemoveStoredVehicle(BGL_VehicleCandidate candidate, BGL_KeyIndex keyIndex, InventoryStorageManagerComponent playerInv)
+	{
+		SCR_EntityHelper.DeleteEntityAndChildren(candidate.m_Vehicle);
+
+		IEntity matchedKey = keyIndex.Find(candidate.m_sKeyId);
+		if (matchedKey)
+			playerInv.TryDeleteItem(matchedKey);
+	}
 
-		// 5) Persist and clean up
-		if (SavePlayerGarageData(storage))
+	/*!
+	    Send the player notification matching a store outcome.
+	    (Occupied vehicles are refused silently, as before.)
+	*/
+	protected void NotifyStoreResult(SCR_PlayerController playerController, EBGL_StoreResult result)
+	{
+		switch (result)
 		{
-			SCR_EntityHelper.DeleteEntityAndChildren(veh);
-			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle has been stored.");
+			case EBGL_StoreResult.STORED:
+				playerController.BGL_Server_RequestNotify("Garage", "Your vehicle has been stored.");
+				break;
+			case EBGL_StoreResult.WEAPONS:
+				playerController.BGL_Server_RequestNotify("Garage", "Weapons in compartment, please remove before storage.");
+				break;
+			case EBGL_StoreResult.GARAGE_FULL:
+				playerController.BGL_Server_RequestNotify("Garage", "Garage is full, can't store more vehicles.");
+				break;
+		}
+	}
+
+	/*!
+	    Send one notification summarizing a StoreAll() pass.
+	    \param refused Count per EBGL_StoreResult of candidates not stored
+	*/
+	protected void NotifyStoreSummary(SCR_PlayerController playerController, int stored, array<int> refused)
+	{
+		string summary = string.Format("Stored %1 vehicles.", stored);
 
-			// Remove the specific matching key from player inventory (quality-of-life)
-			foreach (IEntity item2 : playerInvItems)
+		array<string> reasons = {};
+		if (refused[EBGL_StoreResult.OCCUPIED] > 0)
+			reasons.Insert(string.Format("%1 occupied", refused[EBGL_StoreResult.OCCUPIED]));
+
+		if (refused[EBGL_StoreResult.WEAPONS] > 0)
+			reasons.Insert(string.Format("%1 with weapons", refused[EBGL_StoreResult.WEAPONS]));
+
+		if (refused[EBGL_StoreResult.GARAGE_FULL] > 0)
+			reasons.Insert(string.Format("%1 over the garage limit", refused[EBGL_StoreResult.GARAGE_FULL]));
+
+		if (refused[EBGL_StoreResult.FAILED] > 0)
+			reasons.Insert(string.Format("%1 failed", refused[EBGL_StoreResult.FAILED]));
+
+		if (!reasons.IsEmpty())
+		{
+			summary += " Not stored: " + reasons[0];
+			for (int i = 1; i < reasons.Count(); i++)
 			{
-				string prefabName2 = item2.GetPrefabData().GetPrefabName();
-				if (prefabName2 == "{CCFD8AA837B9611A}Prefabs/Items/CarKey/CarKey.et")
-				{
-					Key_LockComponent keyLockItem = Key_LockComponent.Cast(item2.FindComponent(Key_LockComponent));
-					string keyId2 = keyLockItem.myID;
-					if (keyId2 && keyId2 != "" && keyId2 == m_foundKey)
-						playerInv.TryDeleteItem(item2);
-				}
+				summary += ", " + reasons[i];
 			}
-			return true;
+			summary += ".";
 		}
 
-		return false;
+		playerController.BGL_Server_RequestNotify("Garage", summary);
 	}
 
 	/*!
 	    Spawn a stored vehicle into the world and remove it from storage.
 
 	    Flow:
-	      - Validate indices and storage
-	      - Compute spawn transform (PointInfo or owner transform)
-	      - Ensure spawn area is clear
-	      - Spawn prefab, clear any existing items, then rehydrate saved inventory
-	      - Apply key ID/code to vehicle and a spawned CarKey item
-	      - Save updated storage and notify
+	      - Resolve the vehicle id in storage
+	      - Queue the request in the server-wide BGL_WithdrawalQueue, which
+	        spawns a bounded number of vehicles per frame (TryWithdraw)
+	      - Pick the first clear spawn pad (FindClearPad); while every pad is
+	        blocked the request waits and the player is told their position
+	      - Spawn prefab, record the withdrawal in the cache and apply key ID/code
+	      - Queue a BGL_RehydrationJob that clears default items and restores the
+	        saved inventory over several frames (m_iRehydrateItemsPerTick /
+	        m_fRehydrateBudgetMs)
+	      - On completion (OnRehydrationComplete): unlock, hand over a CarKey
+	        item and notify; a job whose vehicle was deleted or has no
+	        inventory completes as failed
 
 	    Notifications:
-	      - "Can't spawn vehicle, area blocked."
-	      - "Your vehicle has been removed from the garage."
-
-	    \param playerUid    Persistent player UID
-	    \param vehSelected  Index of the stored vehicle to spawn
+	      - "Garage is syncing, try again in a moment." (storage backend fetch in flight)
+	      - "This vehicle is already being withdrawn by another member." (pool checkout lock)
+	      - "All spawn pads are busy. You are number N in the queue."
+	      - "Your vehicle has been removed from the garage." (once populated)
+	      - "Your vehicle was withdrawn, but its inventory could not be restored."
+	      - "Your vehicle was lost before it was ready."
+
+	    \param garageKey    Garage holding the vehicle (player UID or pool key)
+	    \param vehicleId    Id of the stored vehicle to spawn (BGL_VehicleStorageEntity.id)
 	    \param playerId     Runtime player ID (for notifications)
 	*/
-	void LoadCar(string playerUid, int vehSelected, int playerId)
+	void LoadCar(string garageKey, int vehicleId, int playerId)
 	{
-		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
-		BGL_PlayerGarageStorageEntity storage = LoadPlayerGarageData(playerUid);
-		if (!storage || storage.vehicles.IsEmpty())
+		if (!BGL_GaragePools.IsPool(garageKey))
+			BGL_GarageCache.GetInstance().BindPlayer(playerId, garageKey);
+
+		int tick = System.GetTickCount();
+		BGL_PlayerGarageStorageEntity storage = LoadPlayerGarageData(garageKey);
+		BGL_Metrics.Lap("load_load_ms", tick);
+		if (!storage)
 			return;
 
-		if (vehSelected < 0 || vehSelected >= storage.vehicles.Count())
+		if (BGL_GarageCache.GetInstance().IsSyncing(garageKey))
+		{
+			BGL_Metrics.Count("load_syncing_total");
+			SCR_PlayerController syncController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (syncController)
+				syncController.BGL_Server_RequestNotify("Garage", "Garage is syncing, try again in a moment.");
+
 			return;
+		}
 
-		BGL_VehicleStorageEntity vehData = storage.vehicles[vehSelected];
+		BGL_VehicleStorageEntity vehData = storage.FindVehicle(vehicleId);
+		if (!vehData)
+			return;
 
-		// Spawn transform
-		EntitySpawnParams params = EntitySpawnParams();
-		params.TransformMode = ETransformMode.WORLD;
+		if (!BGL_WithdrawalQueue.GetInstance().Enqueue(this, garageKey, vehData, playerId))
+		{
+			BGL_Metrics.Count("load_checked_out_total");
+			SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (playerController)
+				playerController.BGL_Server_RequestNotify("Garage", "This vehicle is already being withdrawn by another member.");
+		}
+	}
 
-		if (m_SpawnPosition)
+	/*!
+	    Withdraw several stored vehicles as a convoy onto this garage's pads.
+	    Each vehicle is queued like LoadCar() and takes the first clear pad
+	    when its turn comes (pads fill one after another; the rest wait for
+	    pads to clear). The player gets one summary once every vehicle has
+	    been handed over (BGL_WithdrawalQueue.OnConvoyVehicleDone) instead of
+	    a notification per vehicle.
+
+	    Vehicles that are no longer stored, whose garage is still syncing or
+	    that another player has checked out are skipped and counted in the summary.
+
+	    \param garageKeys Garage of each vehicle (player UID or pool key), parallel to vehicleIds
+	    \param vehicleIds Ids of the stored vehicles to spawn
+	    \param playerId   Runtime player ID (for notifications)
+	    \return Number of vehicles queued
+	*/
+	int WithdrawConvoy(notnull array<string> garageKeys, notnull array<int> vehicleIds, int playerId)
+	{
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+
+		array<string> keys = {};
+		array<BGL_VehicleStorageEntity> vehicles = {};
+		int skipped;
+		foreach (int i, int vehicleId : vehicleIds)
 		{
-			m_SpawnPosition.Init(GetOwner());
-			m_SpawnPosition.GetModelTransform(params.Transform);
-			params.Transform[3] = GetOwner().CoordToParent(params.Transform[3]);
+			string garageKey = garageKeys[i];
+			if (!BGL_GaragePools.IsPool(garageKey))
+				cache.BindPlayer(playerId, garageKey);
+
+			BGL_PlayerGarageStorageEntity storage = cache.Get(garageKey);
+			BGL_VehicleStorageEntity vehData;
+			if (storage && !cache.IsSyncing(garageKey))
+				vehData = storage.FindVehicle(vehicleId);
+
+			if (!vehData)
+			{
+				skipped++;
+				continue;
+			}
+
+			keys.Insert(garageKey);
+			vehicles.Insert(vehData);
 		}
-		else
+
+		int queued = BGL_WithdrawalQueue.GetInstance().EnqueueConvoy(this, keys, vehicles, playerId, skipped);
+		if (queued == 0)
 		{
-			GetOwner().GetTransform(params.Transform);
+			SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (playerController)
+				playerController.BGL_Server_RequestNotify("Garage", "None of the selected vehicles can be withdrawn right now.");
 		}
 
-		// Area clear check
-		IEntity haveAleardyveh = FindClosestVehicleForLoad(GetOwner().GetOrigin(), 1);
-		if (haveAleardyveh)
+		return queued;
+	}
+
+	/*!
+	    Spawn a stored vehicle on the first clear pad (called by BGL_WithdrawalQueue).
+	    \param vehData   Entry of the player's storage to withdraw
+	    \param convoyId  Convoy the request belongs to (0 = single withdrawal)
+	    \return false if every pad is blocked (nothing changed). If the
+	            storage write fails the spawned vehicle is deleted again and
+	            the entry stays stored (the request is still consumed).
+	*/
+	bool TryWithdraw(string garageKey, BGL_VehicleStorageEntity vehData, int playerId, int convoyId = 0)
+	{
+		// Spawn transform: first clear pad
+		int tick = System.GetTickCount();
+		EntitySpawnParams params = EntitySpawnParams();
+		params.TransformMode = ETransformMode.WORLD;
+		int pad = FindClearPad(params.Transform);
+		tick = BGL_Metrics.Lap("load_area_check_ms", tick);
+		if (pad < 0)
 		{
-			playerController.BGL_Server_RequestNotify("Garage", "Can't spawn vehicle, area blocked.");
-			return;
+			BGL_Metrics.Count("load_blocked_total");
+			return false;
 		}
 
-		// Spawn prefab
-		Resource vehResource = Resource.Load(vehData.prefab);
+		// Spawn prefab (warmed by BGL_PrefabCache when the menu was opened)
+		Resource vehResource = BGL_PrefabCache.GetInstance().Get(vehData.prefab);
+		tick = BGL_Metrics.Lap("load_resource_ms", tick);
 		IEntity veh = GetGame().SpawnEntityPrefab(vehResource, GetOwner().GetWorld(), params);
+		tick = BGL_Metrics.Lap("load_spawn_ms", tick);
+
+		// Remove from storage (journaled as WITHDRAW when enabled); if that
+		// fails the vehicle stays stored, so the spawned copy must go
+		if (veh && !BGL_GarageCache.GetInstance().RemoveVehicle(garageKey, vehData.id, EBGL_JournalOp.WITHDRAW))
+		{
+			BGL_Metrics.Count("load_save_failed_total");
+			SCR_EntityHelper.DeleteEntityAndChildren(veh);
+			veh = null;
+
+			SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(playerId));
+			if (playerController && convoyId == 0)
+				playerController.BGL_Server_RequestNotify("Garage", "Your vehicle could not be withdrawn, try again.");
+		}
 
 		if (veh)
 		{
-			// Remove from storage
-			storage.vehicles.Remove(vehSelected);
+			BGL_Metrics.Count("load_spawned_total");
+			BGL_Metrics.Lap("load_save_ms", tick);
+
+			// Apply lock identity now (also registers the vehicle in BGL_VehicleKeyRegistry);
+			// unlock and key handoff wait for rehydration
+			Key_LockComponent keyLock = Key_LockComponent.Cast(veh.FindComponent(Key_LockComponent));
+			keyLock.SetID(vehData.key_id, vehData.key_id);
+			keyLock.SetCode(vehData.key_code);
+			BGL_VehicleKeyRegistry.GetInstance().RecordUse(vehData.key_id, playerId);
+
+			// Restore fuel, damage and mounted ammo
+			tick = System.GetTickCount();
+			BGL_VehicleStateRegistry.GetInstance().Apply(veh, vehData.state);
+			BGL_Metrics.Lap("load_state_ms", tick);
 
-			// Clear and rehydrate inventory
+			// Clear and rehydrate inventory over the next frames
 			InventoryStorageManagerComponent inventory = InventoryStorageManagerComponent.Cast(veh.FindComponent(InventoryStorageManagerComponent));
-			array<IEntity> items = {};
-			inventory.GetItems(items);
-			foreach (IEntity item : items)
-				inventory.TryDeleteItem(item);
+			BGL_RehydrationJob job = new BGL_RehydrationJob(veh, inventory, vehData, garageKey, playerId);
+			job.m_iConvoyId = convoyId;
+			QueueRehydration(job);
+		}
+		else if (convoyId > 0)
+		{
+			BGL_WithdrawalQueue.GetInstance().OnConvoyVehicleDone(convoyId, false);
+		}
+
+		return true;
+	}
+
+	// =========================================================
+	// Spawn pads (first clear pad)
+	// =========================================================
+
+	/*!
+	    Number of spawn pads: the primary (m_SpawnPosition or owner) plus m_aSpawnPads.
+	*/
+	int GetPadCount()
+	{
+		if (!m_aSpawnPads)
+			return 1;
+
+		return 1 + m_aSpawnPads.Count();
+	}
+
+	/*!
+	    World transform of a pad (0 = primary spawn transform).
+	*/
+	protected void GetPadTransform(int pad, out vector transform[4])
+	{
+		if (pad == 0)
+		{
+			GetSpawnTransform(transform);
+			return;
+		}
+
+		PointInfo point = m_aSpawnPads[pad - 1];
+		point.Init(GetOwner());
+		point.GetModelTransform(transform);
+		transform[3] = GetOwner().CoordToParent(transform[3]);
+	}
+
+	/*!
+	    Find the first pad with no vehicle within m_fPadClearRadius.
+	    \param[out] transform World transform of the chosen pad
+	    \return Pad index, or -1 if every pad is blocked
+	*/
+	protected int FindClearPad(out vector transform[4])
+	{
+		for (int pad; pad < GetPadCount(); pad++)
+		{
+			GetPadTransform(pad, transform);
+			if (!FindClosestVehicleForLoad(transform[3], m_fPadClearRadius))
+				return pad;
+		}
+
+		return -1;
+	}
+
+	// =========================================================
+	// Inventory rehydration (frame-budgeted)
+	// =========================================================
 
-			foreach (string resource, int count : vehData.ToMap())
+	/*!
+	    Add a rehydration job and start the per-frame tick if idle.
+	*/
+	protected void QueueRehydration(BGL_RehydrationJob job)
+	{
+		m_aRehydrationJobs.Insert(job);
+		if (m_aRehydrationJobs.Count() == 1)
+			GetGame().GetCallqueue().CallLater(TickRehydration, 0, true);
+	}
+
+	/*!
+	    Per-frame tick: advance jobs oldest-first within one shared budget
+	    (m_iRehydrateItemsPerTick items / m_fRehydrateBudgetMs). Stops itself
+	    when no jobs remain.
+	*/
+	protected void TickRehydration()
+	{
+		int startTick = System.GetTickCount();
+		BGL_Metrics.Observe("load_rehydrate_queue_jobs", m_aRehydrationJobs.Count());
+
+		while (!m_aRehydrationJobs.IsEmpty())
+		{
+			BGL_RehydrationJob job = m_aRehydrationJobs[0];
+			if (!job.IsValid())
 			{
-				for (int i; i < count; i++)
-					inventory.TrySpawnPrefabToStorage(resource);
+				Print("BGL: withdrawn vehicle was deleted or has no inventory, its inventory was not restored", LogLevel.WARNING);
+				m_aRehydrationJobs.RemoveOrdered(0);
+				OnRehydrationComplete(job, false);
+				continue;
 			}
 
-			// Apply locks/keys
-			Key_LockComponent keyLock = Key_LockComponent.Cast(veh.FindComponent(Key_LockComponent));
-			keyLock.SetID(vehData.key_id, vehData.key_id);
-			keyLock.SetCode(vehData.key_code);
+			if (!job.Step(m_iRehydrateItemsPerTick, startTick, m_fRehydrateBudgetMs))
+				break; // budget spent; continue next frame
+
+			m_aRehydrationJobs.RemoveOrdered(0);
+			BGL_Metrics.Lap("load_rehydrate_ms", job.m_iQueuedTick);
+			OnRehydrationComplete(job, true);
+		}
+
+		BGL_Metrics.Lap("load_rehydrate_tick_ms", startTick);
+
+		if (m_aRehydrationJobs.IsEmpty())
+			GetGame().GetCallqueue().Remove(TickRehydration);
+	}
+
+	/*!
+	    Completion callback for a rehydration job (also for a failed one).
+	    - Unlocks the vehicle, if it still exists
+	    - Spawns a CarKey carrying the vehicle's ID/code and inserts it into the
+	      vehicle inventory (no inventory rescan needed); without an inventory
+	      the key is left at the vehicle
+	    - Notifies the player (convoy vehicles count towards the convoy summary
+	      instead, as failed when not restored)
+
+	    \param restored False if the vehicle was deleted or has no inventory
+	*/
+	protected void OnRehydrationComplete(BGL_RehydrationJob job, bool restored)
+	{
+		BGL_VehicleStorageEntity vehData = job.m_VehData;
+		int tick = System.GetTickCount();
+
+		if (job.m_Vehicle)
+		{
+			Key_LockComponent keyLock = Key_LockComponent.Cast(job.m_Vehicle.FindComponent(Key_LockComponent));
 			keyLock.SetLocked(false);
 
-			// Give a key item and ensure it carries the same ID/code
-			inventory.TrySpawnPrefabToStorage("{CCFD8AA837B9611A}Prefabs/Items/CarKey/CarKey.et");
-			items = {};
-			inventory.GetItems(items);
-			foreach (IEntity item2 : items)
+			EntitySpawnParams keyParams = EntitySpawnParams();
+			keyParams.TransformMode = ETransformMode.WORLD;
+			job.m_Vehicle.GetTransform(keyParams.Transform);
+
+			Resource keyResource = BGL_PrefabCache.GetInstance().Get(CAR_KEY_PREFAB);
+			IEntity key = GetGame().SpawnEntityPrefab(keyResource, GetOwner().GetWorld(), keyParams);
+			if (key)
 			{
-				string prefabName = item2.GetPrefabData().GetPrefabName();
-				if (prefabName == "{CCFD8AA837B9611A}Prefabs/Items/CarKey/CarKey.et")
-				{
-					Key_LockComponent keyLockItem = Key_LockComponent.Cast(item2.FindComponent(Key_LockComponent));
-					string keyId = keyLockItem.myID;
-					if (!keyId)
-					{
-						keyLockItem.SetID(vehData.key_id, vehData.key_id);
-						keyLockItem.SetCode(vehData.key_code);
-					}
-				}
+				Key_LockComponent keyLockItem = Key_LockComponent.Cast(key.FindComponent(Key_LockComponent));
+				keyLockItem.SetID(vehData.key_id, vehData.key_id);
+				keyLockItem.SetCode(vehData.key_code);
+				if (job.m_Inventory)
+					job.m_Inventory.TryInsertItem(key);
 			}
+		}
 
-			// Persist and notify
-			SavePlayerGarageData(storage);
-			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle has been removed from the garage.");
+		BGL_Metrics.Lap("load_key_handoff_ms", tick);
+
+		if (!restored)
+			BGL_Metrics.Count("load_rehydrate_failed_total");
+
+		// Convoy vehicles are reported once for the whole convoy
+		if (job.m_iConvoyId > 0)
+		{
+			BGL_WithdrawalQueue.GetInstance().OnConvoyVehicleDone(job.m_iConvoyId, restored);
+			return;
 		}
 
-		return;
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(job.m_iPlayerId));
+		if (!playerController)
+			return;
+
+		if (restored)
+			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle has been removed from the garage.");
+		else if (job.m_Vehicle)
+			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle was withdrawn, but its inventory could not be restored.");
+		else
+			playerController.BGL_Server_RequestNotify("Garage", "Your vehicle was lost before it was ready.");
 	}
 
 	/*!
-	    Persist the player's storage to disk.
-	    \return true on success
+	    Delete (scrap) one stored vehicle, server-authoritative.
+	    Mutates the cached server copy and persists incrementally (a journaled
+	    DELETE when journal mode is on, otherwise a dirty mark for write-back);
+	    nothing supplied by the client other than the id is trusted.
+
+	    \param garageKey Garage holding the vehicle (player UID or pool key)
+	    \param vehicleId Id of the stored vehicle (BGL_VehicleStorageEntity.id)
+	    \param playerId  Runtime player ID (binds a personal garage to the session
+	                     for flush-on-disconnect; checkout lock owner)
+	    \return false if the garage failed to load or is still syncing with the
+	            storage backend, holds no such vehicle, or another player has
+	            the vehicle checked out
 	*/
-	bool SavePlayerGarageData(BGL_PlayerGarageStorageEntity storage)
+	bool DeleteVehicle(string garageKey, int vehicleId, int playerId)
 	{
-		if (!storage || !storage.player_uid)
+		if (!Replication.IsServer())
+			return false;
+
+		if (BGL_GarageCheckout.GetInstance().IsCheckedOutByOther(garageKey, vehicleId, playerId))
+			return false;
+
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+		if (!BGL_GaragePools.IsPool(garageKey))
+			cache.BindPlayer(playerId, garageKey);
+
+		if (cache.IsSyncing(garageKey))
 			return false;
 
-		string filePath = GetPlayerStoragePath(storage.player_uid);
-		return storage.SaveToFile(filePath);
+		if (!cache.RemoveVehicle(garageKey, vehicleId, EBGL_JournalOp.DELETE))
+			return false;
+
+		BGL_Metrics.Count("delete_total");
+		return true;
+	}
+
+	/*!
+	    Persist the player's storage (server-side whole-garage replace, e.g.
+	    admin tooling). Client actions go through the per-vehicle operations
+	    (Store, LoadCar, DeleteVehicle) instead.
+	    Hands the payload to BGL_GarageCache and marks it dirty; the file is
+	    written back by the cache's flush policy, not on this call.
+	    \return true if the payload was accepted
+	*/
+	bool SavePlayerGarageData(BGL_PlayerGarageStorageEntity storage)
+	{
+		return BGL_GarageCache.GetInstance().Put(storage);
+	}
+
+	/*!
+	    World transform vehicles spawn at (m_SpawnPosition, or the owner transform).
+	*/
+	protected void GetSpawnTransform(out vector transform[4])
+	{
+		if (m_SpawnPosition)
+		{
+			m_SpawnPosition.Init(GetOwner());
+			m_SpawnPosition.GetModelTransform(transform);
+			transform[3] = GetOwner().CoordToParent(transform[3]);
+		}
+		else
+		{
+			GetOwner().GetTransform(transform);
+		}
 	}
 
 	/*!
-	    Snapshot minimal vehicle state (currently prefab path).
-	    Extend here to capture fuel/health/paint/etc.
+	    Snapshot vehicle state: prefab path plus the component state captured
+	    by BGL_VehicleStateRegistry (fuel, hitzones, mounted weapon ammo).
+	    New state goes into a BGL_VehicleStateModule, not here.
 
 	    \param vehicle The world vehicle to capture
 	    \return BGL_VehicleStorageEntity or null
@@ -375,112 +1034,140 @@ class BGL_Component : ScriptComponent
 
 		BGL_VehicleStorageEntity data = new BGL_VehicleStorageEntity();
 		data.prefab = vehicle.GetPrefabData().GetPrefabName();
+		BGL_VehicleStateRegistry.GetInstance().Capture(vehicle, data.state);
 		return data;
 	}
 
-	/*!
-	    Build the absolute storage file path for a player.
-	*/
-	private string GetPlayerStoragePath(string playerUid)
-	{
-		return string.Format("%1%2.json", DATA_DIR, playerUid);
-	}
-
 	/*!
 	    Load or initialize a player's storage payload.
-	    - If file exists, attempts to load; returns null on load failure.
-	    - If not, returns a new payload with player_uid set.
+	    Served from BGL_GarageCache; only a cache miss touches disk (and, with
+	    a remote storage backend, starts a background fetch).
+	    - If the file exists but fails to load, returns null.
+	    - If no file exists, returns a new payload with player_uid set.
 
 	    \return Storage entity (never null on first-time init)
 	*/
 	BGL_PlayerGarageStorageEntity LoadPlayerGarageData(string playerUid)
 	{
-		string filePath = GetPlayerStoragePath(playerUid);
-		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
-
-		if (FileIO.FileExists(filePath))
-		{
-			if (!storage.LoadFromFile(filePath))
-				return null;
-		}
-		else
-		{
-			storage.player_uid = playerUid;
-		}
-
-		return storage;
+		return BGL_GarageCache.GetInstance().Get(playerUid);
 	}
 
 	/*!
-	    Check if the player may store another vehicle (capacity gate).
-	    \return true if count < m_iMaxVehiclesPerPlayer
+	    Check if a garage may hold another vehicle (capacity gate).
+	    \param vehicleCount Vehicles already stored (BGL_GarageCache.GetVehicleCount)
+	    \return true if count < m_iMaxVehiclesPerPool (pools) or m_iMaxVehiclesPerPlayer
 	*/
-	private bool CanStoreMoreVehicles(string playerUid)
+	private bool CanStoreMoreVehicles(string garageKey, int vehicleCount)
 	{
-		BGL_PlayerGarageStorageEntity storage = LoadPlayerGarageData(playerUid);
-		if (!storage)
-			return true;
+		if (BGL_GaragePools.IsPool(garageKey))
+			return vehicleCount < m_iMaxVehiclesPerPool;
 
-		return storage.vehicles.Count() < m_iMaxVehiclesPerPlayer;
+		return vehicleCount < m_iMaxVehiclesPerPlayer;
 	}
 
 	// =========================================================
-	// Spatial Queries (sphere scans)
+	// Spatial Queries (registry lookups + sphere scans)
 	// =========================================================
 
 	/*!
-	    Candidate filter used by FindClosestVehicle.
-	    Accepts entities that:
-	      - Inherit BaseVehicle
-	      - Have a prefab name
-	      - Have a Key_LockComponent whose myID matches one of m_keyIds
-	    On match: m_FoundEntity set and short-circuit (return false).
-
-	    \return false to stop scan, true to continue
+	    Gather every keyed vehicle of the player within m_fRadius of the
+	    configured anchor (m_eCandidateAnchor) and rank them best first.
+	    One registry lookup per held key. Keys that miss the registry (id
+	    assigned without SetID) fall back to one sphere query of m_fRadius
+	    around the anchor; vehicles found that way are registered.
+
+	    \param keyIndex   Player's indexed keys
+	    \param playerId   Acting player (for the recent-withdrawal tie-break)
+	    \param[out] candidates Ranked candidates (nearest first)
 	*/
-	private bool AddEntity(IEntity entity)
+	protected void CollectCandidates(BGL_KeyIndex keyIndex, int playerId, notnull array<ref BGL_VehicleCandidate> candidates)
 	{
-		if (entity && entity.IsInherited(BaseVehicle) && entity.GetPrefabData().GetPrefabName())
+		BGL_VehicleKeyRegistry registry = BGL_VehicleKeyRegistry.GetInstance();
+		float radiusSq = m_fRadius * m_fRadius;
+
+		vector anchor = GetOwner().GetOrigin();
+		if (m_eCandidateAnchor == EBGL_CandidateAnchor.SPAWN_POINT)
 		{
-			Key_LockComponent keyLock = Key_LockComponent.Cast(entity.FindComponent(Key_LockComponent));
-			if (keyLock)
+			vector spawnTransform[4];
+			GetSpawnTransform(spawnTransform);
+			anchor = spawnTransform[3];
+		}
+
+		array<string> keyIds = {};
+		keyIndex.GetKeyIds(keyIds);
+
+		array<IEntity> vehicles = {};
+		set<string> missed = new set<string>();
+		foreach (string keyId : keyIds)
+		{
+			vehicles.Clear();
+			if (registry.FindAll(keyId, vehicles) == 0)
 			{
-				string keyId = keyLock.myID;
-				if (m_keyIds.Contains(keyId))
-				{
-					m_FoundEntity = entity;
-					m_foundKey = keyId;
-					return false; // stop
-				}
+				missed.Insert(keyId);
+				continue;
+			}
+
+			foreach (IEntity vehicle : vehicles)
+			{
+				AddCandidate(vehicle, keyId, anchor, radiusSq, playerId, candidates);
 			}
 		}
-		return true; // continue
+
+		// Fallback for keys whose vehicle never went through the registry hooks
+		if (!missed.IsEmpty())
+		{
+			BGL_Metrics.Count("store_registry_fallback_total");
+			m_MissedKeyIds = missed;
+			m_aFallbackVehicles = {};
+			GetGame().GetWorld().QueryEntitiesBySphere(anchor, m_fRadius, AddMissedKeyVehicle, null, EQueryEntitiesFlags.DYNAMIC);
+
+			foreach (IEntity fallbackVehicle : m_aFallbackVehicles)
+			{
+				Key_LockComponent keyLock = Key_LockComponent.Cast(fallbackVehicle.FindComponent(Key_LockComponent));
+				registry.Register(keyLock.myID, fallbackVehicle);
+				AddCandidate(fallbackVehicle, keyLock.myID, anchor, radiusSq, playerId, candidates);
+			}
+
+			m_MissedKeyIds = null;
+			m_aFallbackVehicles = null;
+		}
+
+		BGL_VehicleCandidate.SortByRank(candidates, m_fCandidateTieDistance, m_bPreferRecentlyWithdrawn);
 	}
 
 	/*!
-	    Find the nearest keyed vehicle within radius of the owner entity.
-
-	    \param entity       Anchor entity (usually the component owner)
-	    \param searchRadius Radius in meters
-	    \return The first matched vehicle entity or null
+	    Add a vehicle as a candidate if it is within the store radius of the anchor.
 	*/
-	private IEntity FindClosestVehicle(IEntity entity, float searchRadius)
+	protected void AddCandidate(IEntity vehicle, string keyId, vector anchor, float radiusSq, int playerId, notnull array<ref BGL_VehicleCandidate> candidates)
 	{
-		if (!entity)
-			return null;
+		float distanceSq = vector.DistanceSq(vehicle.GetOrigin(), anchor);
+		if (distanceSq > radiusSq)
+			return;
 
-		m_FoundEntity = null;
-		vector entityPosition = entity.GetOrigin();
+		BGL_VehicleCandidate candidate = new BGL_VehicleCandidate();
+		candidate.m_Vehicle = vehicle;
+		candidate.m_sKeyId = keyId;
+		candidate.m_fDistanceSq = distanceSq;
+		candidate.m_iLastUseTick = BGL_VehicleKeyRegistry.GetInstance().GetLastUseTick(keyId, playerId);
+		candidates.Insert(candidate);
+	}
 
-		GetGame().GetWorld().QueryEntitiesBySphere(
-			entityPosition,
-			searchRadius,
-			AddEntity,
-			null,
-			EQueryEntitiesFlags.DYNAMIC
-		);
+	/*!
+	    Filter for the CollectCandidates() fallback query: keeps every
+	    BaseVehicle whose lock id is one of m_MissedKeyIds.
 
-		return m_FoundEntity;
+	    \return true to continue the scan
+	*/
+	protected bool AddMissedKeyVehicle(IEntity entity)
+	{
+		if (!entity || !entity.IsInherited(BaseVehicle))
+			return true;
+
+		Key_LockComponent keyLock = Key_LockComponent.Cast(entity.FindComponent(Key_LockComponent));
+		if (keyLock && m_MissedKeyIds.Contains(keyLock.myID))
+			m_aFallbackVehicles.Insert(entity);
+
+		return true;
 	}
 
 	/*!
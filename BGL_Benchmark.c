@@ -0,0 +1,374 @@
+/*!
+    BGL_BenchmarkShape
+    -------------------------
+    Shape of the synthetic garages generated by BGL_Benchmark.
+    Every value can be overridden on the command line (-bglBench<Name>=<n>).
+*/
+class BGL_BenchmarkShape
+{
+	int m_iPlayers = 200;          //!< -bglBenchPlayers: garages generated
+	int m_iVehiclesPerPlayer = 10; //!< -bglBenchVehicles: vehicles per garage
+	int m_iDistinctPrefabs = 40;   //!< -bglBenchPrefabs: distinct item prefabs across all garages
+	int m_iItemsPerVehicle = 20;   //!< -bglBenchItems: inventory slots per vehicle
+	int m_iIterations = 5;         //!< -bglBenchIterations: passes over all garages per operation
+
+	void ReadCLI()
+	{
+		m_iPlayers = ReadInt("bglBenchPlayers", m_iPlayers);
+		m_iVehiclesPerPlayer = ReadInt("bglBenchVehicles", m_iVehiclesPerPlayer);
+		m_iDistinctPrefabs = Math.Max(1, ReadInt("bglBenchPrefabs", m_iDistinctPrefabs));
+		m_iItemsPerVehicle = ReadInt("bglBenchItems", m_iItemsPerVehicle);
+		m_iIterations = Math.Max(1, ReadInt("bglBenchIterations", m_iIterations));
+	}
+
+	string Describe()
+	{
+		return string.Format("players=%1 vehicles=%2 prefabs=%3 items=%4 iterations=%5",
+			m_iPlayers, m_iVehiclesPerPlayer, m_iDistinctPrefabs, m_iItemsPerVehicle, m_iIterations);
+	}
+
+	protected static int ReadInt(string param, int fallback)
+	{
+		string value;
+		if (!System.GetCLIParam(param, value))
+			return fallback;
+
+		return value.ToInt();
+	}
+}
+
+/*!
+    BGL_BenchmarkResult
+    -------------------------
+    Timing samples of one benchmarked operation.
+    Each sample is the mean per-operation time of one batch of BATCH_SIZE garages.
+*/
+class BGL_BenchmarkResult
+{
+	string m_sName;
+	ref array<float> m_aSamples = {}; //!< ms per operation, one entry per batch
+	int m_iOps;                       //!< Operations timed
+	float m_fTotalMs;                 //!< Sum of batch times
+	int m_iPayloadBytes;              //!< Bytes produced per operation (average; 0 if n/a)
+
+	float Percentile(float p)
+	{
+		if (m_aSamples.IsEmpty())
+			return 0;
+
+		array<float> sorted = {};
+		sorted.Copy(m_aSamples);
+		sorted.Sort();
+
+		int index = Math.Floor(p * (sorted.Count() - 1));
+		return sorted[index];
+	}
+
+	string Format()
+	{
+		float opsPerSec;
+		if (m_fTotalMs > 0)
+			opsPerSec = m_iOps * 1000.0 / m_fTotalMs;
+
+		return string.Format("%1\tops=%2\tops/s=%3\tp50_ms=%4\tp99_ms=%5\tpayload_bytes=%6",
+			m_sName, m_iOps, opsPerSec, Percentile(0.5), Percentile(0.99), m_iPayloadBytes);
+	}
+}
+
+/*!
+    BGL_Benchmark
+    -------------------------
+    Reproducible benchmark of garage persistence and serialization, run on a
+    (headless) dedicated server started with -bglBenchmark.
+
+    Operations (one "op" = one whole garage)
+    - json_save / json_load:     JsonApiStruct SaveToFile/LoadFromFile, the disk
+                                 I/O behind SavePlayerGarageData()/LoadPlayerGarageData()
+                                 once BGL_GarageCache flushes or misses
+    - binary_save / binary_load: BGL_GarageBinaryCodec equivalents
+    - from_map / to_map:         BGL_VehicleStorageEntity inventory conversion, every vehicle
+    - pack_expand:               Pack()/AsString()/ExpandFromRAW() of the full storage
+    - delta_pack_expand:         same for a full-resync BGL_GarageDelta (open-menu RPC payload)
+
+    Output
+    - One tab-separated line per operation (throughput, p50/p99 per op,
+      payload bytes per op) in $profile:BLG_bench/results.txt and the log.
+    - -bglBenchmarkExit closes the game when done.
+
+    Notes
+    - Garage contents are generated deterministically from the shape, so runs
+      with the same parameters are comparable across versions.
+    - System.GetTickCount() has millisecond resolution; operations are timed
+      in batches of BATCH_SIZE and divided, and percentiles are over batches.
+    - Script exposes no allocator statistics; payload bytes (JSON string or
+      file size) stand in for allocated bytes per operation.
+    - One operation runs per frame; files are written to $profile:BLG_bench/,
+      never to the live garage directory.
+*/
+class BGL_Benchmark
+{
+	static const int BATCH_SIZE = 16;
+	static const string BENCH_DIR = "$profile:BLG_bench/";
+
+	protected static ref BGL_Benchmark s_Instance;
+
+	protected ref BGL_BenchmarkShape m_Shape = new BGL_BenchmarkShape();
+	protected ref array<ref BGL_PlayerGarageStorageEntity> m_aGarages = {};
+	protected ref array<ref BGL_BenchmarkResult> m_aResults = {};
+	protected ref array<string> m_aPending = {}; //!< Operations still to run (in order)
+
+	/*!
+	    Start the benchmark if the server was launched with -bglBenchmark
+	    (once per session; later calls are ignored).
+	*/
+	static void StartFromCLI()
+	{
+		if (s_Instance || !System.IsCLIParam("bglBenchmark"))
+			return;
+
+		s_Instance = new BGL_Benchmark();
+		s_Instance.Start();
+	}
+
+	// =========================================================
+	// Run
+	// =========================================================
+
+	protected void Start()
+	{
+		m_Shape.ReadCLI();
+		FileIO.MakeDirectory(BENCH_DIR);
+		Generate();
+
+		m_aPending = { "json_save", "json_load", "binary_save", "binary_load", "from_map", "to_map", "pack_expand", "delta_pack_expand" };
+
+		Print("BGL: benchmark started, " + m_Shape.Describe(), LogLevel.NORMAL);
+		GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+
+	/*!
+	    Per-frame tick: run the next operation.
+	*/
+	protected void Tick()
+	{
+		if (m_aPending.IsEmpty())
+		{
+			Finish();
+			return;
+		}
+
+		string name = m_aPending[0];
+		m_aPending.RemoveOrdered(0);
+
+		BGL_BenchmarkResult result = new BGL_BenchmarkResult();
+		result.m_sName = name;
+		Run(result);
+		m_aResults.Insert(result);
+	}
+
+	protected void Finish()
+	{
+		GetGame().GetCallqueue().Remove(Tick);
+
+		FileHandle file = FileIO.OpenFile(BENCH_DIR + "results.txt", FileMode.WRITE);
+		if (file)
+			file.WriteLine(m_Shape.Describe());
+
+		foreach (BGL_BenchmarkResult result : m_aResults)
+		{
+			string line = result.Format();
+			Print("BGL bench: " + line, LogLevel.NORMAL);
+			if (file)
+				file.WriteLine(line);
+		}
+
+		if (file)
+			file.Close();
+
+		foreach (BGL_PlayerGarageStorageEntity storage : m_aGarages)
+		{
+			FileIO.DeleteFile(GetPath(storage, ".json"));
+			FileIO.DeleteFile(GetPath(storage, ".bglb"));
+		}
+
+		if (System.IsCLIParam("bglBenchmarkExit"))
+			GetGame().RequestClose();
+	}
+
+	/*!
+	    Time every garage through one operation, m_iIterations times, in batches.
+	*/
+	protected void Run(BGL_BenchmarkResult result)
+	{
+		int garages = m_aGarages.Count();
+
+		// File sizes are measured up front so no extra file open lands in the timed batches
+		int payloadSum = GetFilePayloadSum(result.m_sName);
+
+		for (int iteration; iteration < m_Shape.m_iIterations; iteration++)
+		{
+			for (int batchStart = 0; batchStart < garages; batchStart += BATCH_SIZE)
+			{
+				int batchEnd = Math.Min(batchStart + BATCH_SIZE, garages);
+
+				int startTick = System.GetTickCount();
+				for (int i = batchStart; i < batchEnd; i++)
+				{
+					int bytes = RunOne(result.m_sName, m_aGarages[i]);
+					if (iteration == 0)
+						payloadSum += bytes;
+				}
+
+				float batchMs = System.GetTickCount() - startTick;
+				result.m_fTotalMs += batchMs;
+				result.m_iOps += batchEnd - batchStart;
+				result.m_aSamples.Insert(batchMs / (batchEnd - batchStart));
+			}
+		}
+
+		if (garages > 0)
+			result.m_iPayloadBytes = payloadSum / garages;
+	}
+
+	/*!
+	    Total on-disk size of the garages' files for the load operations
+	    (written by the preceding save run), 0 for the others.
+	*/
+	protected int GetFilePayloadSum(string name)
+	{
+		string extension;
+		if (name == "json_load")
+			extension = ".json";
+		else if (name == "binary_load")
+			extension = ".bglb";
+		else
+			return 0;
+
+		int sum;
+		foreach (BGL_PlayerGarageStorageEntity storage : m_aGarages)
+		{
+			sum += BGL_GarageWriter.GetFileSize(GetPath(storage, extension));
+		}
+		return sum;
+	}
+
+	/*!
+	    Run one operation on one garage.
+	    \return Payload bytes produced in memory (0 if not applicable)
+	*/
+	protected int RunOne(string name, BGL_PlayerGarageStorageEntity storage)
+	{
+		if (name == "json_save")
+		{
+			storage.SaveToFile(GetPath(storage, ".json"));
+			return 0;
+		}
+
+		if (name == "json_load")
+		{
+			BGL_PlayerGarageStorageEntity loaded = new BGL_PlayerGarageStorageEntity();
+			loaded.LoadFromFile(GetPath(storage, ".json"));
+			return 0;
+		}
+
+		if (name == "binary_save")
+		{
+			BGL_GarageBinaryCodec.SaveToFile(storage, GetPath(storage, ".bglb"));
+			return 0;
+		}
+
+		if (name == "binary_load")
+		{
+			BGL_GarageBinaryCodec.LoadFromFile(GetPath(storage, ".bglb"));
+			return 0;
+		}
+
+		if (name == "from_map")
+		{
+			foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+			{
+				BGL_VehicleStorageEntity rebuilt = new BGL_VehicleStorageEntity();
+				rebuilt.FromMap(vehicle.ToMap());
+			}
+			return 0;
+		}
+
+		if (name == "to_map")
+		{
+			foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+			{
+				vehicle.ToMap();
+			}
+			return 0;
+		}
+
+		if (name == "pack_expand")
+		{
+			storage.Pack();
+			string raw = storage.AsString();
+			BGL_PlayerGarageStorageEntity expanded = new BGL_PlayerGarageStorageEntity();
+			expanded.ExpandFromRAW(raw);
+			return raw.Length();
+		}
+
+		if (name == "delta_pack_expand")
+		{
+			BGL_GarageDelta delta = new BGL_GarageDelta();
+			delta.revision = storage.revision;
+			delta.full = true;
+			foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+			{
+				delta.vehicles.Insert(BGL_VehicleSummary.FromVehicle(vehicle));
+			}
+
+			delta.Pack();
+			string deltaRaw = delta.AsString();
+			BGL_GarageDelta expandedDelta = new BGL_GarageDelta();
+			expandedDelta.ExpandFromRAW(deltaRaw);
+			return deltaRaw.Length();
+		}
+
+		return 0;
+	}
+
+	// =========================================================
+	// Synthetic data
+	// =========================================================
+
+	/*!
+	    Build m_iPlayers garages; contents depend only on the shape.
+	*/
+	protected void Generate()
+	{
+		for (int p; p < m_Shape.m_iPlayers; p++)
+		{
+			BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
+			storage.player_uid = string.Format("bench-%1", p);
+
+			for (int v = 0; v < m_Shape.m_iVehiclesPerPlayer; v++)
+			{
+				BGL_VehicleStorageEntity vehicle = new BGL_VehicleStorageEntity();
+				vehicle.prefab = string.Format("{0000000000000000}Prefabs/Bench/Vehicle_%1.et", (p + v) % 8);
+				vehicle.key_id = string.Format("%1-%2-%3", p, v, p * 7919 + v);
+				vehicle.key_code = string.Format("%1", (p * 31 + v * 17) % 10000);
+
+				for (int i = 0; i < m_Shape.m_iItemsPerVehicle; i++)
+				{
+					BGL_VehicleInventorySlot slot = new BGL_VehicleInventorySlot();
+					slot.prefab = string.Format("{0000000000000000}Prefabs/Bench/Item_%1.et", (p * 13 + v * 7 + i) % m_Shape.m_iDistinctPrefabs);
+					slot.count = 1 + (p + v + i) % 5;
+					vehicle.inventory.Insert(slot);
+				}
+
+				storage.AddVehicle(vehicle);
+			}
+
+			m_aGarages.Insert(storage);
+		}
+	}
+
+	protected string GetPath(BGL_PlayerGarageStorageEntity storage, string extension)
+	{
+		return BENCH_DIR + storage.player_uid + extension;
+	}
+}
@@ -0,0 +1,476 @@
+/*!
+    BGL_BinaryWriter
+    -------------------------
+    Buffered byte sink for BGL_GarageBinaryCodec. Varint bytes are packed
+    four to a word and written with one FileHandle.Write per word; strings
+    go out with one call each. A short write marks the writer as failed.
+*/
+class BGL_BinaryWriter
+{
+	protected FileHandle m_File;
+	protected int m_iWord;   //!< Pending bytes, little-endian
+	protected int m_iBytes;  //!< Number of pending bytes (0-3)
+	protected bool m_bFailed; //!< A write came back short
+
+	void BGL_BinaryWriter(FileHandle file)
+	{
+		m_File = file;
+	}
+
+	void WriteByte(int value)
+	{
+		m_iWord = m_iWord | ((value & 0xFF) << (m_iBytes * 8));
+		m_iBytes++;
+		if (m_iBytes == 4)
+			Flush();
+	}
+
+	void WriteRaw(string value)
+	{
+		Flush();
+		if (!value.IsEmpty() && m_File.Write(value, value.Length()) != value.Length())
+			m_bFailed = true;
+	}
+
+	//! Write pending bytes (call before closing the file).
+	void Flush()
+	{
+		if (m_iBytes == 0)
+			return;
+
+		if (m_File.Write(m_iWord, m_iBytes) != m_iBytes)
+			m_bFailed = true;
+
+		m_iWord = 0;
+		m_iBytes = 0;
+	}
+
+	//! True if any write came back short.
+	bool HasFailed()
+	{
+		return m_bFailed;
+	}
+}
+
+/*!
+    BGL_BinaryReader
+    -------------------------
+    Buffered byte source for BGL_GarageBinaryCodec: reads up to four bytes
+    per FileHandle.Read for varints and whole strings in one call.
+*/
+class BGL_BinaryReader
+{
+	protected FileHandle m_File;
+	protected int m_iRemaining; //!< Bytes left in the file past the buffer
+	protected int m_iWord;      //!< Buffered bytes, next one in the low byte
+	protected int m_iBytes;     //!< Number of buffered bytes (0-3)
+
+	void BGL_BinaryReader(FileHandle file)
+	{
+		m_File = file;
+		m_iRemaining = file.GetLength();
+	}
+
+	bool ReadByte(out int value)
+	{
+		if (m_iBytes == 0)
+		{
+			int take = Math.Min(4, m_iRemaining);
+			if (take == 0)
+				return false;
+
+			m_iWord = 0;
+			if (m_File.Read(m_iWord, take) != take)
+				return false;
+
+			m_iRemaining -= take;
+			m_iBytes = take;
+		}
+
+		value = m_iWord & 0xFF;
+		m_iWord = (m_iWord >> 8) & 0x00FFFFFF;
+		m_iBytes--;
+		return true;
+	}
+
+	bool ReadRaw(int length, out string value)
+	{
+		value = string.Empty;
+
+		// Bytes already buffered (at most three)
+		while (length > 0 && m_iBytes > 0)
+		{
+			int ch;
+			ReadByte(ch);
+			value += ch.AsciiToString();
+			length--;
+		}
+
+		if (length == 0)
+			return true;
+
+		if (length > m_iRemaining)
+			return false;
+
+		string rest;
+		if (m_File.Read(rest, length) != length)
+			return false;
+
+		m_iRemaining -= length;
+		value += rest;
+		return true;
+	}
+}
+
+/*!
+    BGL_GarageBinaryCodec
+    -------------------------
+    Compact, versioned binary encoding of BGL_PlayerGarageStorageEntity.
+    Alternative to the per-player JSON file; selected server-wide with
+    BGL_Component.m_bBinaryStorage and loaded through the same
+    BGL_GarageCache / LoadPlayerGarageData() path.
+
+    Layout (version 5)
+      magic        4 bytes  "BGLB"
+      version      varint
+      player_uid   string
+      revision     varint
+      journal_seq  varint
+      next_vehicle_id varint                           (v2+)
+      backend_version varint                           (v5+)
+      backend_revision varint                          (v5+)
+      table        varint count, then count strings   (interned prefab names)
+      vehicles     varint count, then per vehicle:
+        id           varint                           (v2+)
+        prefab       varint table index
+        key_id       string
+        key_code     string
+        inventory    varint count, then per slot:
+          prefab       varint table index
+          count        varint
+          parent       varint, stored + 1 (-1 → 0)     (v4+)
+          storage      varint, stored + 1              (v4+)
+          slot         varint, stored + 1              (v4+)
+        state        fuel, hitzones, ammo: each a varint count,  (v3+)
+                     then count varints (BGL_VehicleState)
+
+    Encoding
+    - varint: unsigned LEB128 (7 bits per byte, high bit = continuation).
+      All encoded integers are non-negative.
+    - string: varint byte length followed by the bytes.
+    - Every vehicle and item prefab ResourceName is stored once in the string
+      table and referenced by index, so repeated prefabs cost 1-2 bytes.
+    - File I/O goes through BGL_BinaryWriter / BGL_BinaryReader, which batch
+      varint bytes into words and move strings in one call.
+
+    Conversion
+    - Decode(Encode(x)) reproduces every serialized field of x, so
+      JsonToBinary()/BinaryToJson() round-trip losslessly.
+    - Older versions are still decoded; fields they lack keep their defaults
+      (version 1 vehicles get ids from BGL_GarageCache on load).
+*/
+class BGL_GarageBinaryCodec
+{
+	static const string MAGIC = "BGLB";
+	static const int VERSION = 5;
+
+	// =========================================================
+	// Public API
+	// =========================================================
+
+	/*!
+	    Write storage to path in the binary format.
+	    \return true on success (false if the file cannot be opened or a write fails)
+	*/
+	static bool SaveToFile(BGL_PlayerGarageStorageEntity storage, string path)
+	{
+		FileHandle handle = FileIO.OpenFile(path, FileMode.WRITE);
+		if (!handle)
+			return false;
+
+		BGL_BinaryWriter file = new BGL_BinaryWriter(handle);
+
+		// Intern prefab names
+		array<string> table = {};
+		map<string, int> tableIndex = new map<string, int>();
+		foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+		{
+			Intern(vehicle.prefab, table, tableIndex);
+			foreach (BGL_VehicleInventorySlot slot : vehicle.inventory)
+			{
+				Intern(slot.prefab, table, tableIndex);
+			}
+		}
+
+		file.WriteRaw(MAGIC);
+		WriteVarint(file, VERSION);
+		WriteString(file, storage.player_uid);
+		WriteVarint(file, storage.revision);
+		WriteVarint(file, storage.journal_seq);
+		WriteVarint(file, storage.next_vehicle_id);
+		WriteVarint(file, storage.backend_version);
+		WriteVarint(file, storage.backend_revision);
+
+		WriteVarint(file, table.Count());
+		foreach (string entry : table)
+		{
+			WriteString(file, entry);
+		}
+
+		WriteVarint(file, storage.vehicles.Count());
+		foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+		{
+			WriteVarint(file, vehicle.id);
+			WriteVarint(file, tableIndex.Get(vehicle.prefab));
+			WriteString(file, vehicle.key_id);
+			WriteString(file, vehicle.key_code);
+
+			WriteVarint(file, vehicle.inventory.Count());
+			foreach (BGL_VehicleInventorySlot slot : vehicle.inventory)
+			{
+				WriteVarint(file, tableIndex.Get(slot.prefab));
+				WriteVarint(file, slot.count);
+				WriteVarint(file, slot.parent + 1);
+				WriteVarint(file, slot.storage + 1);
+				WriteVarint(file, slot.slot + 1);
+			}
+
+			WriteIntArray(file, vehicle.state.fuel);
+			WriteIntArray(file, vehicle.state.hitzones);
+			WriteIntArray(file, vehicle.state.ammo);
+		}
+
+		file.Flush();
+		handle.Close();
+		return !file.HasFailed();
+	}
+
+	/*!
+	    Read storage from a binary file.
+	    \return Storage entity, or null if the file is missing, truncated,
+	            has the wrong magic or an unsupported version
+	*/
+	static BGL_PlayerGarageStorageEntity LoadFromFile(string path)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return null;
+
+		BGL_PlayerGarageStorageEntity storage = Decode(new BGL_BinaryReader(file));
+		file.Close();
+		return storage;
+	}
+
+	/*!
+	    Convert a JSON player file to the binary format.
+	    \return true on success
+	*/
+	static bool JsonToBinary(string jsonPath, string binaryPath)
+	{
+		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
+		if (!storage.LoadFromFile(jsonPath))
+			return false;
+
+		return SaveToFile(storage, binaryPath);
+	}
+
+	/*!
+	    Convert a binary player file back to JSON.
+	    \return true on success
+	*/
+	static bool BinaryToJson(string binaryPath, string jsonPath)
+	{
+		BGL_PlayerGarageStorageEntity storage = LoadFromFile(binaryPath);
+		if (!storage)
+			return false;
+
+		return storage.SaveToFile(jsonPath);
+	}
+
+	// =========================================================
+	// Decoding
+	// =========================================================
+
+	protected static BGL_PlayerGarageStorageEntity Decode(BGL_BinaryReader file)
+	{
+		string magic;
+		if (!file.ReadRaw(MAGIC.Length(), magic) || magic != MAGIC)
+			return null;
+
+		int version;
+		if (!ReadVarint(file, version) || version < 1 || version > VERSION)
+			return null;
+
+		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
+		if (!ReadString(file, storage.player_uid) || !ReadVarint(file, storage.revision) || !ReadVarint(file, storage.journal_seq))
+			return null;
+
+		if (version >= 2 && !ReadVarint(file, storage.next_vehicle_id))
+			return null;
+
+		if (version >= 5 && (!ReadVarint(file, storage.backend_version) || !ReadVarint(file, storage.backend_revision)))
+			return null;
+
+		int tableCount;
+		if (!ReadVarint(file, tableCount))
+			return null;
+
+		array<string> table = {};
+		for (int i; i < tableCount; i++)
+		{
+			string entry;
+			if (!ReadString(file, entry))
+				return null;
+
+			table.Insert(entry);
+		}
+
+		int vehicleCount;
+		if (!ReadVarint(file, vehicleCount))
+			return null;
+
+		for (int v; v < vehicleCount; v++)
+		{
+			BGL_VehicleStorageEntity vehicle = new BGL_VehicleStorageEntity();
+			if (version >= 2 && !ReadVarint(file, vehicle.id))
+				return null;
+
+			int prefabIndex;
+			if (!ReadVarint(file, prefabIndex) || prefabIndex >= tableCount)
+				return null;
+
+			vehicle.prefab = table[prefabIndex];
+			if (!ReadString(file, vehicle.key_id) || !ReadString(file, vehicle.key_code))
+				return null;
+
+			int slotCount;
+			if (!ReadVarint(file, slotCount))
+				return null;
+
+			for (int s; s < slotCount; s++)
+			{
+				BGL_VehicleInventorySlot slot = new BGL_VehicleInventorySlot();
+
+				int slotPrefab;
+				if (!ReadVarint(file, slotPrefab) || slotPrefab >= tableCount || !ReadVarint(file, slot.count))
+					return null;
+
+				slot.prefab = table[slotPrefab];
+
+				if (version >= 4)
+				{
+					if (!ReadVarint(file, slot.parent) || !ReadVarint(file, slot.storage) || !ReadVarint(file, slot.slot))
+						return null;
+
+					slot.parent--;
+					slot.storage--;
+					slot.slot--;
+				}
+
+				vehicle.inventory.Insert(slot);
+			}
+
+			if (version >= 3)
+			{
+				if (!ReadIntArray(file, vehicle.state.fuel) || !ReadIntArray(file, vehicle.state.hitzones) || !ReadIntArray(file, vehicle.state.ammo))
+					return null;
+			}
+
+			storage.vehicles.Insert(vehicle);
+		}
+
+		return storage;
+	}
+
+	// =========================================================
+	// Primitives
+	// =========================================================
+
+	protected static void Intern(string value, notnull array<string> table, notnull map<string, int> tableIndex)
+	{
+		if (tableIndex.Contains(value))
+			return;
+
+		tableIndex.Insert(value, table.Count());
+		table.Insert(value);
+	}
+
+	protected static void WriteVarint(BGL_BinaryWriter file, int value)
+	{
+		if (value < 0)
+		{
+			Print("BGL: negative value in binary garage encoding, stored as 0", LogLevel.WARNING);
+			value = 0;
+		}
+
+		while (value >= 0x80)
+		{
+			file.WriteByte((value & 0x7F) | 0x80);
+			value = value >> 7;
+		}
+
+		file.WriteByte(value);
+	}
+
+	protected static bool ReadVarint(BGL_BinaryReader file, out int value)
+	{
+		value = 0;
+		int shift;
+		while (shift < 35)
+		{
+			int chunk;
+			if (!file.ReadByte(chunk))
+				return false;
+
+			value = value | ((chunk & 0x7F) << shift);
+			if ((chunk & 0x80) == 0)
+				return true;
+
+			shift += 7;
+		}
+
+		return false; // malformed (more than 5 bytes)
+	}
+
+	protected static void WriteIntArray(BGL_BinaryWriter file, array<int> values)
+	{
+		WriteVarint(file, values.Count());
+		foreach (int value : values)
+		{
+			WriteVarint(file, value);
+		}
+	}
+
+	protected static bool ReadIntArray(BGL_BinaryReader file, notnull array<int> values)
+	{
+		int count;
+		if (!ReadVarint(file, count))
+			return false;
+
+		for (int i; i < count; i++)
+		{
+			int value;
+			if (!ReadVarint(file, value))
+				return false;
+
+			values.Insert(value);
+		}
+
+		return true;
+	}
+
+	protected static void WriteString(BGL_BinaryWriter file, string value)
+	{
+		WriteVarint(file, value.Length());
+		file.WriteRaw(value);
+	}
+
+	protected static bool ReadString(BGL_BinaryReader file, out string value)
+	{
+		int length;
+		if (!ReadVarint(file, length))
+			return false;
+
+		return file.ReadRaw(length, value);
+	}
+}
@@ -0,0 +1,1375 @@
+/*!
+    BGL_GarageCacheEntry
+    -------------------------
+    One cached player garage held by BGL_GarageCache.
+
+    Fields
+    - m_Storage:     The authoritative in-memory payload while cached.
+    - m_bDirty:      True when m_Storage has changes not yet written to disk
+                     (neither in the snapshot nor in the journal).
+    - m_iJournalRecords: Records appended to the journal since the last compaction.
+    - m_aDeltaLog:   Recent mutations for BuildDelta() (bounded, in memory only).
+    - m_iLastAccess: Tick count of the last Get()/Put() (LRU ordering).
+    - m_bOnline:     True while the owning player is connected (never evicted).
+*/
+class BGL_GarageCacheEntry
+{
+	ref BGL_PlayerGarageStorageEntity m_Storage;
+	bool m_bDirty;
+	int m_iJournalRecords;
+	ref array<ref BGL_GarageDeltaOp> m_aDeltaLog = new array<ref BGL_GarageDeltaOp>();
+	int m_iLastAccess;
+	bool m_bOnline;
+}
+
+/*!
+    BGL_GarageCache
+    -------------------------
+    Server-wide, UID-keyed write-back cache for player garage storage.
+    Every BGL_Component on the server shares the same instance, so a player
+    hitting several garage signs reads their file once.
+
+    Responsibilities
+    - Load a player's storage from disk on first access, then serve it from memory.
+    - Track dirty entries and write them back on a flush policy:
+        • every FLUSH_INTERVAL_MS (periodic)
+        • when the owning player disconnects
+        • on shutdown (BGL_Component.OnDelete → FlushAll)
+      Write-back only queues a job on BGL_GarageWriter, which writes a few
+      garages per frame (coalesced per UID, atomic replace); FlushAll() is
+      the barrier that waits for every queued write.
+    - Evict least-recently-used entries of disconnected players once more than
+      MAX_OFFLINE_ENTRIES are held. Online players are never evicted.
+    - Optional journal mode (SetJournalMode): AddVehicle()/RemoveVehicle()
+      append a small record to BGL_GarageJournal instead of dirtying the entry;
+      the journal is compacted into the snapshot every JOURNAL_COMPACT_INTERVAL_MS,
+      after JOURNAL_COMPACT_RECORDS records, and when the owner disconnects.
+
+    - Keep a short log of recent mutations so the open-menu RPC can send a
+      diff since the client's revision instead of the whole garage (BuildDelta).
+    - Sync with a remote storage backend (SetBackend, BGL_StorageBackend):
+      read-through (a garage loaded from memory/local files is fetched in
+      the background and replaced if the backend holds a newer version) and
+      batched commits (changed garages every flush interval and on
+      disconnect, SYNC_BATCH_SIZE per request) with optimistic versioning.
+
+    Files
+    - Sharded by UID hash: $profile:BLG/<shard>/<playerUid>.json, where <shard>
+      is two hex digits of playerUid.Hash() (256 subdirectories).
+    - Binary mode (SetBinaryMode, BGL_GarageBinaryCodec) writes <playerUid>.bglb
+      instead. Loads accept either file; a garage found in the inactive format
+      is marked dirty so the next flush rewrites it in the active one and
+      removes the old file.
+    - Journal mode adds <shard>/<playerUid>.journal. Any journal found at
+      load time is replayed, whichever mode is active.
+    - <file>.tmp is the writer's temp file; it is loaded when <file> is
+      missing or unreadable (crash during the replace).
+    - $profile:BLG/index.json: BGL_GarageIndex (vehicle count, modified time,
+      file size per UID), queued on the writer with every flush pass. GetVehicleCount()
+      answers from it for garages that are not cached.
+
+    Layout migration
+    - Files from the old flat layout ($profile:BLG/<playerUid>.*) are moved
+      into their shard on first access to that player, and in the background
+      (MIGRATIONS_PER_FRAME players per frame) starting at construction.
+
+    Backend conflicts
+    - A commit based on an older version than the backend's (another server
+      wrote the garage meanwhile) is rejected. The backend's copy is adopted
+      and the local one kept as <shard>/<key>.<unixtime>.conflict for
+      recovery. A garage changed locally while its fetch reports a newer
+      version is resolved the same way without the round trip.
+    - A backend behind the local version (reset or restored) gets the local
+      copy written over it.
+    - Mutations wait for a garage's fetch (IsSyncing); if the fetch fails the
+      local copy is used and conflicts surface at the next commit.
+
+    Notes
+    - Keys are garage keys: a player UID, or a pool key (BGL_GaragePools)
+      shared by every member, so a pool is read once and all members'
+      requests mutate the same cached copy.
+    - Server only. Callers mutate the returned storage in place and then call
+      MarkDirty()/Put() so the change is picked up by the next flush.
+    - Player id → UID bindings come from the garage actions (BindPlayer), so
+      disconnects can be resolved without querying the backend.
+*/
+class BGL_GarageCache
+{
+	// -----------------------------
+	// Tunables
+	// -----------------------------
+
+	static const int FLUSH_INTERVAL_MS = 30000;  //!< Periodic write-back interval
+	static const int MAX_OFFLINE_ENTRIES = 64;   //!< LRU capacity for disconnected players
+	static const int JOURNAL_COMPACT_INTERVAL_MS = 300000; //!< Scheduled journal compaction
+	static const int JOURNAL_COMPACT_RECORDS = 32;         //!< Size threshold for compaction
+	static const int DELTA_LOG_SIZE = 32;                  //!< Mutations kept for menu diffs
+	static const int MIGRATIONS_PER_FRAME = 8;             //!< Flat-layout players moved per frame
+	static const int SYNC_INTERVAL_MS = 250;               //!< Backend batching window
+	static const int SYNC_BATCH_SIZE = 16;                 //!< Garages per backend request
+	static const int SYNC_RETRY_MS = 5000;                 //!< Backoff after a failed backend request
+
+	// -----------------------------
+	// Internals
+	// -----------------------------
+
+	protected const string DATA_DIR = "$profile:BLG/"; //!< Save directory
+	protected const string INDEX_PATH = "$profile:BLG/index.json"; //!< Global garage index
+	protected const string INDEX_NAME = "index";                   //!< Index file name (skipped by migration)
+	protected const string HEX_DIGITS = "0123456789abcdef";
+
+	protected static ref BGL_GarageCache s_Instance;
+
+	protected ref map<string, ref BGL_GarageCacheEntry> m_Entries; //!< UID → cached entry
+	protected ref map<int, string> m_PlayerUids;                   //!< Runtime player id → UID
+	protected bool m_bJournalMode;                                 //!< Append-only persistence enabled
+	protected bool m_bBinaryMode;                                  //!< Snapshots written with BGL_GarageBinaryCodec
+	protected ref BGL_GarageIndex m_Index;                         //!< Per-UID summary (index.json)
+	protected ref BGL_GarageWriter m_Writer;                       //!< Deferred snapshot writes
+	protected ref set<string> m_CreatedShards;                     //!< Shard directories ensured this session
+	protected ref array<string> m_aMigrationQueue;                 //!< Flat-layout UIDs still to move
+	protected ref set<string> m_MigrationQueued;                   //!< Dedupe for m_aMigrationQueue
+	protected array<string> m_aListedUids;                         //!< GetStoredUids() output while listing
+	protected ref set<string> m_ListedUids;                        //!< Dedupe for m_aListedUids
+	protected ref BGL_StorageBackend m_Backend;                    //!< Durable store (files unless SetBackend)
+	protected ref array<string> m_aFetchQueue;                     //!< Keys waiting for a backend fetch
+	protected ref set<string> m_Fetching;                          //!< Keys queued or in flight for fetch
+	protected ref array<string> m_aCommitQueue;                    //!< Keys waiting for a backend commit
+	protected ref map<string, int> m_Committing;                   //!< Keys in flight for commit → revision sent
+	protected bool m_bFetchInFlight;                               //!< A fetch batch awaits its reply
+	protected bool m_bCommitInFlight;                              //!< A commit batch awaits its reply
+	protected int m_iSyncRetryTick;                                //!< No backend requests before this tick
+
+	// =========================================================
+	// Lifecycle
+	// =========================================================
+
+	/*!
+	    Return the server-wide cache, creating it on first use.
+	*/
+	static BGL_GarageCache GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_GarageCache();
+
+		return s_Instance;
+	}
+
+	/*!
+	    Constructor
+	    - Ensures save directory exists, loads the garage index and creates the writer
+	    - Queues flat-layout files for background migration
+	    - Starts the periodic flush and journal compaction
+	    - Hooks player disconnects from the game mode
+	*/
+	void BGL_GarageCache()
+	{
+		m_Entries = new map<string, ref BGL_GarageCacheEntry>();
+		m_PlayerUids = new map<int, string>();
+		m_CreatedShards = new set<string>();
+		m_aMigrationQueue = {};
+		m_MigrationQueued = new set<string>();
+		m_aFetchQueue = {};
+		m_Fetching = new set<string>();
+		m_aCommitQueue = {};
+		m_Committing = new map<string, int>();
+
+		m_Backend = new BGL_FileStorageBackend();
+		m_Backend.Attach(this);
+
+		FileIO.MakeDirectory(DATA_DIR);
+
+		m_Index = new BGL_GarageIndex();
+		if (!m_Index.Load(INDEX_PATH))
+			Print("BGL: garage index failed to load, rebuilding as garages are written", LogLevel.WARNING);
+
+		m_Writer = new BGL_GarageWriter(m_Index);
+
+		StartLayoutMigration();
+
+		GetGame().GetCallqueue().CallLater(OnFlushInterval, FLUSH_INTERVAL_MS, true);
+		GetGame().GetCallqueue().CallLater(CompactAll, JOURNAL_COMPACT_INTERVAL_MS, true);
+
+		SCR_BaseGameMode gameMode = SCR_BaseGameMode.Cast(GetGame().GetGameMode());
+		if (gameMode)
+			gameMode.GetOnPlayerDisconnected().Insert(OnPlayerDisconnected);
+	}
+
+	// =========================================================
+	// Public API
+	// =========================================================
+
+	/*!
+	    Return the cached storage for a player, loading it from disk on a miss.
+	    - A garage still waiting in the writer is taken from there (its file is stale).
+	    - If no file exists, a new payload with player_uid set is cached.
+	    - With a remote backend, a miss also queues a background fetch (IsSyncing).
+
+	    \param playerUid Persistent player UID
+	    \return Storage entity, or null if the file exists but failed to load
+	*/
+	BGL_PlayerGarageStorageEntity Get(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry)
+		{
+			MigrateFlatFiles(playerUid);
+
+			bool migrate;
+			BGL_PlayerGarageStorageEntity storage = m_Writer.GetPending(playerUid);
+			if (!storage)
+				storage = ReadFromDisk(playerUid, migrate);
+
+			if (!storage)
+				return null;
+
+			entry = new BGL_GarageCacheEntry();
+			entry.m_Storage = storage;
+			entry.m_bDirty = migrate;
+
+			// Garages saved before vehicle ids existed
+			if (storage.AssignMissingIds() > 0)
+				entry.m_bDirty = true;
+			entry.m_bOnline = IsUidOnline(playerUid);
+
+			// Fold any journal left on disk; outside journal mode it is
+			// rewritten into the snapshot on the next flush.
+			entry.m_iJournalRecords = BGL_GarageJournal.Replay(storage, GetJournalPath(playerUid));
+			if (entry.m_iJournalRecords > 0 && !m_bJournalMode)
+				entry.m_bDirty = true;
+
+			m_Entries.Insert(playerUid, entry);
+
+			if (m_Backend.IsRemote())
+				QueueFetch(playerUid);
+		}
+
+		entry.m_iLastAccess = System.GetTickCount();
+		return entry.m_Storage;
+	}
+
+	/*!
+	    Load a garage if needed and report whether its backend fetch is still
+	    in flight. Mutations should wait until it lands (the cached copy may
+	    be older than another server's).
+	*/
+	bool IsSyncing(string playerUid)
+	{
+		Get(playerUid);
+		return m_Fetching.Contains(playerUid);
+	}
+
+	/*!
+	    Number of vehicles a player has stored.
+	    Served from the cached entry, else from the garage index; only a player
+	    missing from both is loaded from disk.
+	    \return Vehicle count, or -1 if the storage failed to load
+	*/
+	int GetVehicleCount(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (entry)
+			return entry.m_Storage.vehicles.Count();
+
+		BGL_GarageIndexEntry indexed = m_Index.Find(playerUid);
+		if (indexed)
+			return indexed.vehicle_count;
+
+		BGL_PlayerGarageStorageEntity storage = Get(playerUid);
+		if (!storage)
+			return -1;
+
+		return storage.vehicles.Count();
+	}
+
+	/*!
+	    Collect the UID of every garage stored in the sharded layout
+	    (one directory listing per shard; intended for maintenance, not hot paths).
+	*/
+	void GetStoredUids(notnull array<string> outUids)
+	{
+		m_aListedUids = outUids;
+		m_ListedUids = new set<string>();
+
+		for (int bucket; bucket < 256; bucket++)
+		{
+			string shardDir = string.Format("%1%2%3/", DATA_DIR, HEX_DIGITS.Get(bucket >> 4), HEX_DIGITS.Get(bucket & 0x0F));
+			FileIO.FindFiles(OnStoredFileFound, shardDir, ".json");
+			FileIO.FindFiles(OnStoredFileFound, shardDir, ".bglb");
+			FileIO.FindFiles(OnStoredFileFound, shardDir, ".journal");
+		}
+
+		m_aListedUids = null;
+		m_ListedUids = null;
+	}
+
+	/*!
+	    Write back and drop a player's cached entry unless the player is online.
+	    \return true if the entry is no longer cached
+	*/
+	bool Evict(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry)
+			return true;
+
+		if (entry.m_bOnline || IsSyncPending(playerUid) || !Compact(playerUid))
+			return false;
+
+		m_Entries.Remove(playerUid);
+		return true;
+	}
+
+	/*!
+	    Move a player's unreadable files aside (<file>.corrupt) so the garage
+	    starts empty instead of failing every load. Drops any cached entry
+	    and the index entry.
+	    \return true if every file was moved
+	*/
+	bool Quarantine(string playerUid)
+	{
+		m_Entries.Remove(playerUid);
+		m_Index.Remove(playerUid);
+		m_Writer.Cancel(playerUid);
+
+		bool moved = QuarantineFile(GetPlayerStoragePath(playerUid));
+		moved = QuarantineFile(GetBinaryStoragePath(playerUid)) && moved;
+		moved = QuarantineFile(GetJournalPath(playerUid)) && moved;
+		return moved;
+	}
+
+	/*!
+	    Global garage index (read-only use, e.g. admin tooling).
+	*/
+	BGL_GarageIndex GetIndex()
+	{
+		return m_Index;
+	}
+
+	/*!
+	    Replace (or insert) a player's cached storage and mark it dirty.
+	    \param storage Payload with player_uid set
+	    \return false if storage is invalid
+	*/
+	bool Put(BGL_PlayerGarageStorageEntity storage)
+	{
+		if (!storage || !storage.player_uid)
+			return false;
+
+		BGL_GarageCacheEntry entry = m_Entries.Get(storage.player_uid);
+		if (!entry)
+		{
+			entry = new BGL_GarageCacheEntry();
+			entry.m_bOnline = IsUidOnline(storage.player_uid);
+			m_Entries.Insert(storage.player_uid, entry);
+		}
+		else if (entry.m_Storage)
+		{
+			// Bulk replace: move past every revision a client may hold, forcing a full resync
+			storage.revision = Math.Max(storage.revision, entry.m_Storage.revision) + 1;
+		}
+
+		entry.m_aDeltaLog.Clear();
+		entry.m_Storage = storage;
+		entry.m_bDirty = true;
+		entry.m_iLastAccess = System.GetTickCount();
+		m_Index.SetVehicleCount(storage.player_uid, storage.vehicles.Count());
+		return true;
+	}
+
+	/*!
+	    Append a vehicle to a player's garage.
+	    Journal mode appends a STORE record; otherwise the entry is marked dirty.
+	    \return true if the change was accepted (written to the journal or queued for flush)
+	*/
+	bool AddVehicle(string playerUid, BGL_VehicleStorageEntity vehicle)
+	{
+		BGL_GarageJournalRecord record = new BGL_GarageJournalRecord();
+		record.op = EBGL_JournalOp.STORE;
+		record.vehicle = vehicle;
+		array<ref BGL_GarageJournalRecord> records = {record};
+		return ApplyRecords(playerUid, records) == 1;
+	}
+
+	/*!
+	    Append several vehicles to a garage as one change: one journal append
+	    in journal mode, otherwise one dirty mark (so one snapshot write).
+	    \return Number of vehicles accepted, in order (all of them unless the journal write fails)
+	*/
+	int AddVehicles(string playerUid, notnull array<ref BGL_VehicleStorageEntity> vehicles)
+	{
+		array<ref BGL_GarageJournalRecord> records = {};
+		foreach (BGL_VehicleStorageEntity vehicle : vehicles)
+		{
+			BGL_GarageJournalRecord record = new BGL_GarageJournalRecord();
+			record.op = EBGL_JournalOp.STORE;
+			record.vehicle = vehicle;
+			records.Insert(record);
+		}
+
+		return ApplyRecords(playerUid, records);
+	}
+
+	/*!
+	    Remove a vehicle from a player's garage by id.
+	    \param op EBGL_JournalOp.WITHDRAW or EBGL_JournalOp.DELETE
+	    \return true if the change was accepted (false if no vehicle has this id)
+	*/
+	bool RemoveVehicle(string playerUid, int vehicleId, EBGL_JournalOp op)
+	{
+		BGL_GarageJournalRecord record = new BGL_GarageJournalRecord();
+		record.op = op;
+		record.vehicle_id = vehicleId;
+		array<ref BGL_GarageJournalRecord> records = {record};
+		return ApplyRecords(playerUid, records) == 1;
+	}
+
+	/*!
+	    Build the open-menu payload for a client that holds sinceRevision.
+	    - Same revision → empty diff
+	    - Every op since sinceRevision still logged → diff
+	    - Otherwise (first open, evicted/reloaded entry, bulk replace) → full summary list
+
+	    \param sinceRevision Revision last sent to this client (-1 if none)
+	    \return Delta, or null if the storage failed to load
+	*/
+	BGL_GarageDelta BuildDelta(string playerUid, int sinceRevision)
+	{
+		BGL_PlayerGarageStorageEntity storage = Get(playerUid);
+		if (!storage)
+			return null;
+
+		BGL_GarageDeltaOp firstOp;
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry.m_aDeltaLog.IsEmpty())
+			firstOp = entry.m_aDeltaLog[0];
+
+		BGL_GarageDelta delta = new BGL_GarageDelta();
+		delta.garage_key = playerUid;
+		delta.base_revision = sinceRevision;
+		delta.revision = storage.revision;
+
+		if (sinceRevision == storage.revision)
+			return delta;
+
+		if (sinceRevision >= 0 && sinceRevision < storage.revision && firstOp && firstOp.revision <= sinceRevision + 1)
+		{
+			foreach (BGL_GarageDeltaOp op : entry.m_aDeltaLog)
+			{
+				if (op.revision > sinceRevision)
+					delta.ops.Insert(op);
+			}
+			return delta;
+		}
+
+		delta.full = true;
+		foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+		{
+			delta.vehicles.Insert(BGL_VehicleSummary.FromVehicle(vehicle));
+		}
+		return delta;
+	}
+
+	/*!
+	    Enable or disable append-only journal persistence (server-wide).
+	*/
+	void SetJournalMode(bool enabled)
+	{
+		m_bJournalMode = enabled;
+	}
+
+	/*!
+	    Select the snapshot format (server-wide): binary (.bglb) or JSON (.json).
+	*/
+	void SetBinaryMode(bool enabled)
+	{
+		m_bBinaryMode = enabled;
+	}
+
+	/*!
+	    Use a remote storage backend (server-wide; the first one set wins) and
+	    start the sync tick. The local files remain the read-through cache.
+	*/
+	void SetBackend(notnull BGL_StorageBackend backend)
+	{
+		if (m_Backend.IsRemote())
+			return;
+
+		m_Backend = backend;
+		m_Backend.Attach(this);
+
+		if (m_Backend.IsRemote())
+			GetGame().GetCallqueue().CallLater(TickSync, SYNC_INTERVAL_MS, true);
+	}
+
+	/*!
+	    Flag a player's cached storage as modified (written on next flush).
+	*/
+	void MarkDirty(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (entry)
+			entry.m_bDirty = true;
+	}
+
+	/*!
+	    Associate a runtime player id with their UID and mark the entry online.
+	    Called by garage actions so disconnects can be mapped back to a UID.
+	*/
+	void BindPlayer(int playerId, string playerUid)
+	{
+		m_PlayerUids.Set(playerId, playerUid);
+
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (entry)
+			entry.m_bOnline = true;
+	}
+
+	/*!
+	    Queue a single player's storage for writing if it is dirty.
+	    Writing the snapshot also folds (and discards) any pending journal.
+	    \return true if nothing was pending or the write was queued
+	*/
+	bool Flush(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry || !entry.m_bDirty)
+			return true;
+
+		return QueueSnapshot(playerUid, entry);
+	}
+
+	/*!
+	    Fold a player's journal into the snapshot (compaction, queued).
+	    \return true if nothing was pending or the write was queued
+	*/
+	bool Compact(string playerUid)
+	{
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry || (!entry.m_bDirty && entry.m_iJournalRecords == 0))
+			return true;
+
+		return QueueSnapshot(playerUid, entry);
+	}
+
+	/*!
+	    Compact every cached journal (scheduled compaction).
+	*/
+	void CompactAll()
+	{
+		foreach (string playerUid, BGL_GarageCacheEntry entry : m_Entries)
+		{
+			Compact(playerUid);
+		}
+	}
+
+	/*!
+	    Commit changed garages to a remote backend (blocking), then write
+	    every dirty entry and every queued write to disk, then the garage
+	    index (shutdown barrier).
+	    \return true if every write succeeded
+	*/
+	bool FlushAll()
+	{
+		bool committed = CommitAll();
+
+		foreach (string playerUid, BGL_GarageCacheEntry entry : m_Entries)
+		{
+			Flush(playerUid);
+		}
+
+		m_Writer.EnqueueIndex(INDEX_PATH);
+		return m_Writer.Drain() && committed;
+	}
+
+	/*!
+	    Write every queued snapshot now (barrier without queuing dirty entries).
+	    \return true if every write succeeded
+	*/
+	bool DrainWrites()
+	{
+		return m_Writer.Drain();
+	}
+
+	// =========================================================
+	// Flush policy
+	// =========================================================
+
+	/*!
+	    Periodic callback: queue dirty entries for the writer and changed ones
+	    for a backend commit, queue the index write, then trim offline entries.
+	*/
+	protected void OnFlushInterval()
+	{
+		foreach (string playerUid, BGL_GarageCacheEntry entry : m_Entries)
+		{
+			Flush(playerUid);
+			QueueCommitIfChanged(playerUid, entry);
+		}
+
+		m_Writer.EnqueueIndex(INDEX_PATH);
+		EvictOffline();
+	}
+
+	/*!
+	    Game mode callback: flush the leaving player's garage and allow eviction.
+	*/
+	protected void OnPlayerDisconnected(int playerId, KickCauseCode cause, int timeout)
+	{
+		string playerUid;
+		if (!m_PlayerUids.Find(playerId, playerUid))
+			return;
+
+		m_PlayerUids.Remove(playerId);
+
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (!entry)
+			return;
+
+		entry.m_bOnline = IsUidOnline(playerUid);
+		Compact(playerUid);
+		QueueCommitIfChanged(playerUid, entry);
+	}
+
+	/*!
+	    Route a batch of mutations through the journal (one append) or the
+	    dirty flag, then log them for menu diffs. Stops at the first record
+	    that does not apply.
+	    \return Number of records applied
+	*/
+	protected int ApplyRecords(string playerUid, notnull array<ref BGL_GarageJournalRecord> records)
+	{
+		BGL_PlayerGarageStorageEntity storage = Get(playerUid);
+		if (!storage)
+			return 0;
+
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		int applied;
+		if (!m_bJournalMode)
+		{
+			foreach (BGL_GarageJournalRecord record : records)
+			{
+				if (record.op == EBGL_JournalOp.STORE)
+					storage.AddVehicle(record.vehicle);
+				else if (!storage.RemoveVehicle(record.vehicle_id))
+					break;
+
+				applied++;
+			}
+
+			if (applied > 0)
+				entry.m_bDirty = true;
+		}
+		else
+		{
+			applied = BGL_GarageJournal.AppendAll(storage, GetJournalPath(playerUid), records);
+			entry.m_iJournalRecords += applied;
+		}
+
+		if (applied == 0)
+			return 0;
+
+		// Every applied record bumped the revision by one
+		int firstRevision = storage.revision - applied + 1;
+		for (int i = 0; i < applied; i++)
+		{
+			LogDelta(entry, records[i], firstRevision + i);
+		}
+
+		if (m_bJournalMode && entry.m_iJournalRecords >= JOURNAL_COMPACT_RECORDS)
+			Compact(playerUid);
+
+		m_Index.SetVehicleCount(playerUid, storage.vehicles.Count());
+		return applied;
+	}
+
+	/*!
+	    Append an applied mutation to the bounded delta log.
+	*/
+	protected void LogDelta(BGL_GarageCacheEntry entry, BGL_GarageJournalRecord record, int revision)
+	{
+		BGL_GarageDeltaOp op = new BGL_GarageDeltaOp();
+		op.op = record.op;
+		op.vehicle_id = record.vehicle_id;
+		op.revision = revision;
+		if (record.vehicle)
+		{
+			op.vehicle_id = record.vehicle.id;
+			op.vehicle = BGL_VehicleSummary.FromVehicle(record.vehicle);
+		}
+
+		entry.m_aDeltaLog.Insert(op);
+		if (entry.m_aDeltaLog.Count() > DELTA_LOG_SIZE)
+			entry.m_aDeltaLog.RemoveOrdered(0);
+	}
+
+	/*!
+	    Drop least-recently-used offline entries above MAX_OFFLINE_ENTRIES.
+	    Pending changes are queued for the writer first (which keeps serving
+	    them to Get() until written); an entry that cannot be queued is kept.
+	*/
+	protected void EvictOffline()
+	{
+		int offline;
+		foreach (string playerUid, BGL_GarageCacheEntry entry : m_Entries)
+		{
+			if (!entry.m_bOnline)
+				offline++;
+		}
+
+		while (offline > MAX_OFFLINE_ENTRIES)
+		{
+			string oldestUid;
+			int oldestAccess;
+			bool found;
+
+			foreach (string uid, BGL_GarageCacheEntry candidate : m_Entries)
+			{
+				if (candidate.m_bOnline || IsSyncPending(uid))
+					continue;
+
+				if (!found || candidate.m_iLastAccess < oldestAccess)
+				{
+					oldestUid = uid;
+					oldestAccess = candidate.m_iLastAccess;
+					found = true;
+				}
+			}
+
+			if (!found || !Compact(oldestUid))
+				return;
+
+			m_Entries.Remove(oldestUid);
+			offline--;
+		}
+	}
+
+	/*!
+	    True if any bound runtime player id still maps to this UID.
+	*/
+	protected bool IsUidOnline(string playerUid)
+	{
+		foreach (int playerId, string uid : m_PlayerUids)
+		{
+			if (uid == playerUid)
+				return true;
+		}
+		return false;
+	}
+
+	// =========================================================
+	// Backend sync
+	// =========================================================
+
+	/*!
+	    Backend reply to a fetch batch (called by the backend).
+	    \param keys  Keys of the batch
+	    \param found Documents the backend holds (keys without one have no remote copy)
+	*/
+	void OnFetchReply(notnull array<string> keys, notnull array<ref BGL_StorageDocument> found)
+	{
+		m_bFetchInFlight = false;
+
+		map<string, BGL_StorageDocument> documents = new map<string, BGL_StorageDocument>();
+		foreach (BGL_StorageDocument document : found)
+		{
+			documents.Set(document.key, document);
+		}
+
+		foreach (string playerUid : keys)
+		{
+			m_Fetching.RemoveItem(playerUid);
+
+			// Evicted meanwhile: fetched again on the next load
+			BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+			if (entry)
+				MergeFetched(playerUid, entry, documents.Get(playerUid));
+		}
+	}
+
+	/*!
+	    Backend reply to a commit batch (called by the backend).
+	    \param keys    Keys of the batch
+	    \param results Per-write outcome (writes without one are retried)
+	*/
+	void OnCommitReply(notnull array<string> keys, notnull array<ref BGL_StorageCommitResult> results)
+	{
+		m_bCommitInFlight = false;
+
+		foreach (BGL_StorageCommitResult result : results)
+		{
+			int sentRevision;
+			if (!m_Committing.Find(result.key, sentRevision))
+				continue;
+
+			m_Committing.Remove(result.key);
+
+			BGL_GarageCacheEntry entry = m_Entries.Get(result.key);
+			if (!entry)
+				continue;
+
+			BGL_PlayerGarageStorageEntity storage = entry.m_Storage;
+			if (result.ok)
+			{
+				storage.backend_version = result.version;
+				storage.backend_revision = sentRevision;
+				entry.m_bDirty = true; // persist the new base version locally
+				BGL_Metrics.Count("backend_committed_total");
+				continue;
+			}
+
+			if (result.version < storage.backend_version)
+			{
+				// The backend lost our copy (reset/restore): write ours over it
+				storage.backend_version = result.version;
+				QueueCommit(result.key);
+				continue;
+			}
+
+			AdoptRemote(result.key, result.version, result.garage, true);
+		}
+
+		foreach (string playerUid : keys)
+		{
+			if (!m_Committing.Contains(playerUid))
+				continue;
+
+			m_Committing.Remove(playerUid);
+			QueueCommit(playerUid);
+		}
+	}
+
+	/*!
+	    A backend request failed (called by the backend).
+	    Commits are re-queued; fetched garages fall back to their local copy.
+	    Further requests wait SYNC_RETRY_MS.
+	*/
+	void OnBackendFailed(notnull array<string> keys, bool commit)
+	{
+		m_iSyncRetryTick = System.GetTickCount() + SYNC_RETRY_MS;
+
+		if (!commit)
+		{
+			m_bFetchInFlight = false;
+			foreach (string playerUid : keys)
+			{
+				m_Fetching.RemoveItem(playerUid);
+			}
+			return;
+		}
+
+		m_bCommitInFlight = false;
+		foreach (string playerUid : keys)
+		{
+			m_Committing.Remove(playerUid);
+			QueueCommit(playerUid);
+		}
+	}
+
+	/*!
+	    Sync tick: send one fetch batch and one commit batch if none is in flight.
+	*/
+	protected void TickSync()
+	{
+		if (System.GetTickCount() < m_iSyncRetryTick)
+			return;
+
+		if (!m_bFetchInFlight && !m_aFetchQueue.IsEmpty())
+		{
+			array<string> keys = {};
+			while (keys.Count() < SYNC_BATCH_SIZE && !m_aFetchQueue.IsEmpty())
+			{
+				keys.Insert(m_aFetchQueue[0]);
+				m_aFetchQueue.RemoveOrdered(0);
+			}
+
+			m_bFetchInFlight = true;
+			m_Backend.Fetch(keys);
+		}
+
+		if (!m_bCommitInFlight && !m_aCommitQueue.IsEmpty())
+		{
+			array<ref BGL_StorageDocument> writes = {};
+			while (writes.Count() < SYNC_BATCH_SIZE && !m_aCommitQueue.IsEmpty())
+			{
+				string playerUid = m_aCommitQueue[0];
+				m_aCommitQueue.RemoveOrdered(0);
+
+				// Evicted, or re-queued by its fetch reply if still needed
+				BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+				if (entry && !m_Fetching.Contains(playerUid))
+					writes.Insert(BuildCommit(playerUid, entry));
+			}
+
+			if (!writes.IsEmpty())
+			{
+				m_bCommitInFlight = true;
+				m_Backend.Commit(writes, false);
+			}
+		}
+	}
+
+	/*!
+	    Commit every changed garage in one blocking batch (shutdown).
+	    Garages in an in-flight batch are left to it.
+	    \return true if nothing was pending or every write was answered
+	*/
+	protected bool CommitAll()
+	{
+		if (!m_Backend.IsRemote())
+			return true;
+
+		array<ref BGL_StorageDocument> writes = {};
+		foreach (string playerUid, BGL_GarageCacheEntry entry : m_Entries)
+		{
+			if (HasUncommittedChanges(entry) && !m_Committing.Contains(playerUid) && !m_Fetching.Contains(playerUid))
+				writes.Insert(BuildCommit(playerUid, entry));
+		}
+
+		m_aCommitQueue.Clear();
+		if (writes.IsEmpty())
+			return true;
+
+		bool inFlight = m_bCommitInFlight;
+		m_Backend.Commit(writes, true);
+		m_bCommitInFlight = inFlight;
+
+		return m_aCommitQueue.IsEmpty();
+	}
+
+	/*!
+	    Reconcile a cached garage with the backend's copy (doc null: none).
+	*/
+	protected void MergeFetched(string playerUid, BGL_GarageCacheEntry entry, BGL_StorageDocument doc)
+	{
+		BGL_PlayerGarageStorageEntity storage = entry.m_Storage;
+
+		int remoteVersion;
+		if (doc)
+			remoteVersion = doc.version;
+
+		if (remoteVersion > storage.backend_version)
+		{
+			AdoptRemote(playerUid, doc.version, doc.garage, HasUncommittedChanges(entry));
+			return;
+		}
+
+		bool commit = HasUncommittedChanges(entry) || (!doc && !storage.vehicles.IsEmpty());
+		if (remoteVersion < storage.backend_version)
+		{
+			// The backend lost our copy (reset/restore): write ours over it
+			storage.backend_version = remoteVersion;
+			commit = true;
+		}
+
+		if (commit)
+			QueueCommit(playerUid);
+	}
+
+	/*!
+	    Replace a cached garage with the backend's copy. Clients resync in
+	    full (Put); the local files follow on the next flush.
+	    \param keepLocal Save the replaced copy as a .conflict file first
+	*/
+	protected void AdoptRemote(string playerUid, int version, BGL_PlayerGarageStorageEntity remote, bool keepLocal)
+	{
+		if (!remote)
+			remote = new BGL_PlayerGarageStorageEntity();
+
+		BGL_GarageCacheEntry entry = m_Entries.Get(playerUid);
+		if (keepLocal && entry)
+			KeepConflictCopy(playerUid, entry.m_Storage);
+
+		remote.player_uid = playerUid;
+		remote.AssignMissingIds();
+		Put(remote);
+
+		remote.backend_version = version;
+		remote.backend_revision = remote.revision;
+		BGL_Metrics.Count("backend_adopted_total");
+	}
+
+	/*!
+	    Save a garage that lost a version conflict next to its snapshot.
+	*/
+	protected void KeepConflictCopy(string playerUid, BGL_PlayerGarageStorageEntity storage)
+	{
+		EnsureShardDir(playerUid);
+
+		string path = string.Format("%1%2.%3.conflict", GetShardDir(playerUid), playerUid, System.GetUnixTime());
+		storage.SaveToFile(path);
+
+		Print(string.Format("BGL: garage %1 was changed on another server, local copy kept as %2", playerUid, path), LogLevel.WARNING);
+		BGL_Metrics.Count("backend_conflict_total");
+	}
+
+	/*!
+	    Commit document for a cached garage; records the revision being sent.
+	*/
+	protected BGL_StorageDocument BuildCommit(string playerUid, BGL_GarageCacheEntry entry)
+	{
+		BGL_StorageDocument write = new BGL_StorageDocument();
+		write.key = playerUid;
+		write.version = entry.m_Storage.backend_version;
+		write.garage = entry.m_Storage;
+
+		m_Committing.Set(playerUid, entry.m_Storage.revision);
+		return write;
+	}
+
+	protected void QueueFetch(string playerUid)
+	{
+		if (m_Fetching.Contains(playerUid))
+			return;
+
+		m_Fetching.Insert(playerUid);
+		m_aFetchQueue.Insert(playerUid);
+	}
+
+	protected void QueueCommit(string playerUid)
+	{
+		if (m_Committing.Contains(playerUid) || m_aCommitQueue.Contains(playerUid))
+			return;
+
+		m_aCommitQueue.Insert(playerUid);
+	}
+
+	/*!
+	    Queue a backend commit if the garage changed since its last one
+	    (remote backends only).
+	*/
+	protected void QueueCommitIfChanged(string playerUid, BGL_GarageCacheEntry entry)
+	{
+		if (m_Backend.IsRemote() && HasUncommittedChanges(entry) && !m_Fetching.Contains(playerUid))
+			QueueCommit(playerUid);
+	}
+
+	protected bool HasUncommittedChanges(BGL_GarageCacheEntry entry)
+	{
+		return entry.m_Storage.backend_revision != entry.m_Storage.revision;
+	}
+
+	/*!
+	    True while a garage has a backend fetch or commit queued or in flight
+	    (kept cached until the reply lands).
+	*/
+	protected bool IsSyncPending(string playerUid)
+	{
+		return m_Fetching.Contains(playerUid) || m_Committing.Contains(playerUid) || m_aCommitQueue.Contains(playerUid);
+	}
+
+	// =========================================================
+	// Disk I/O
+	// =========================================================
+
+	/*!
+	    Shard subdirectory name for a player: two hex digits of the UID hash.
+	*/
+	protected string GetShardName(string playerUid)
+	{
+		int bucket = playerUid.Hash() & 0xFF;
+		return HEX_DIGITS.Get(bucket >> 4) + HEX_DIGITS.Get(bucket & 0x0F);
+	}
+
+	/*!
+	    Build the shard directory path for a player (with trailing slash).
+	*/
+	protected string GetShardDir(string playerUid)
+	{
+		return string.Format("%1%2/", DATA_DIR, GetShardName(playerUid));
+	}
+
+	/*!
+	    Create a player's shard directory once per session.
+	*/
+	protected void EnsureShardDir(string playerUid)
+	{
+		string shard = GetShardName(playerUid);
+		if (m_CreatedShards.Contains(shard))
+			return;
+
+		FileIO.MakeDirectory(GetShardDir(playerUid));
+		m_CreatedShards.Insert(shard);
+	}
+
+	/*!
+	    Build the absolute storage file path for a player.
+	*/
+	protected string GetPlayerStoragePath(string playerUid)
+	{
+		return string.Format("%1%2.json", GetShardDir(playerUid), playerUid);
+	}
+
+	/*!
+	    Build the binary storage file path for a player.
+	*/
+	protected string GetBinaryStoragePath(string playerUid)
+	{
+		return string.Format("%1%2.bglb", GetShardDir(playerUid), playerUid);
+	}
+
+	/*!
+	    Build the journal file path for a player.
+	*/
+	protected string GetJournalPath(string playerUid)
+	{
+		return BGL_GarageJournal.GetPath(GetShardDir(playerUid), playerUid);
+	}
+
+	/*!
+	    Queue the snapshot for an entry on the writer, in the active format.
+	    The writer removes the other format's file and discards the (then
+	    folded) journal once the snapshot is in place.
+	*/
+	protected bool QueueSnapshot(string playerUid, BGL_GarageCacheEntry entry)
+	{
+		if (!entry.m_Storage || entry.m_Storage.player_uid != playerUid)
+			return false;
+
+		EnsureShardDir(playerUid);
+
+		BGL_GarageWriteJob job = new BGL_GarageWriteJob();
+		job.m_Storage = entry.m_Storage;
+		job.m_bBinary = m_bBinaryMode;
+		job.m_sPath = GetPlayerStoragePath(playerUid);
+		job.m_sStalePath = GetBinaryStoragePath(playerUid);
+		if (m_bBinaryMode)
+		{
+			job.m_sPath = GetBinaryStoragePath(playerUid);
+			job.m_sStalePath = GetPlayerStoragePath(playerUid);
+		}
+		job.m_sJournalPath = GetJournalPath(playerUid);
+
+		m_Writer.Enqueue(job);
+		entry.m_bDirty = false;
+		entry.m_iJournalRecords = 0;
+		return true;
+	}
+
+	/*!
+	    Load or initialize a player's storage payload from disk.
+	    - Tries the active format's file first, then the other format.
+	    - If a file exists, attempts to load; returns null on load failure.
+	    - If neither exists, returns a new payload with player_uid set.
+	    \param[out] migrate True if the payload came from the inactive format
+	*/
+	protected BGL_PlayerGarageStorageEntity ReadFromDisk(string playerUid, out bool migrate)
+	{
+		string jsonPath = GetPlayerStoragePath(playerUid);
+		string binaryPath = GetBinaryStoragePath(playerUid);
+
+		bool useBinary;
+		if (SnapshotExists(binaryPath) && (m_bBinaryMode || !SnapshotExists(jsonPath)))
+			useBinary = true;
+
+		BGL_PlayerGarageStorageEntity storage;
+		if (useBinary)
+		{
+			storage = LoadSnapshot(binaryPath, true);
+			if (!storage)
+				return null;
+		}
+		else if (SnapshotExists(jsonPath))
+		{
+			storage = LoadSnapshot(jsonPath, false);
+			if (!storage)
+				return null;
+		}
+		else
+		{
+			storage = new BGL_PlayerGarageStorageEntity();
+			storage.player_uid = playerUid;
+			return storage;
+		}
+
+		migrate = useBinary != m_bBinaryMode;
+		return storage;
+	}
+
+	/*!
+	    True if a snapshot or its writer temp file exists.
+	*/
+	protected bool SnapshotExists(string path)
+	{
+		return FileIO.FileExists(path) || FileIO.FileExists(path + BGL_GarageWriter.TMP_SUFFIX);
+	}
+
+	/*!
+	    Load one snapshot file, falling back to the writer's temp file when the
+	    file is missing or fails to parse (crash during an atomic replace).
+	    \return Storage entity, or null if neither loads
+	*/
+	protected BGL_PlayerGarageStorageEntity LoadSnapshot(string path, bool binary)
+	{
+		BGL_PlayerGarageStorageEntity storage = LoadSnapshotFile(path, binary);
+		if (storage)
+			return storage;
+
+		string tmpPath = path + BGL_GarageWriter.TMP_SUFFIX;
+		storage = LoadSnapshotFile(tmpPath, binary);
+		if (storage)
+			Print(string.Format("BGL: recovered %1 from %2", path, tmpPath), LogLevel.WARNING);
+
+		return storage;
+	}
+
+	protected BGL_PlayerGarageStorageEntity LoadSnapshotFile(string path, bool binary)
+	{
+		if (!FileIO.FileExists(path))
+			return null;
+
+		if (binary)
+			return BGL_GarageBinaryCodec.LoadFromFile(path);
+
+		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
+		if (!storage.LoadFromFile(path))
+			return null;
+
+		return storage;
+	}
+
+	/*!
+	    FindFiles callback for GetStoredUids().
+	*/
+	protected void OnStoredFileFound(string fileName, FileAttribute attributes = 0, string filesystem = string.Empty)
+	{
+		string playerUid = FilePath.StripExtension(FilePath.StripPath(fileName));
+		if (playerUid == "" || m_ListedUids.Contains(playerUid))
+			return;
+
+		m_ListedUids.Insert(playerUid);
+		m_aListedUids.Insert(playerUid);
+	}
+
+	/*!
+	    Rename one file to <file>.corrupt (no-op if it does not exist).
+	*/
+	protected bool QuarantineFile(string path)
+	{
+		if (!FileIO.FileExists(path))
+			return true;
+
+		if (!FileIO.CopyFile(path, path + ".corrupt"))
+			return false;
+
+		return FileIO.DeleteFile(path);
+	}
+
+	// =========================================================
+	// Layout migration (flat → sharded)
+	// =========================================================
+
+	/*!
+	    Queue every player with files in the flat layout and start the
+	    background migration tick.
+	*/
+	protected void StartLayoutMigration()
+	{
+		FileIO.FindFiles(OnFlatFileFound, DATA_DIR, ".json");
+		FileIO.FindFiles(OnFlatFileFound, DATA_DIR, ".bglb");
+		FileIO.FindFiles(OnFlatFileFound, DATA_DIR, ".journal");
+
+		if (!m_aMigrationQueue.IsEmpty())
+		{
+			Print(string.Format("BGL: migrating %1 garages to the sharded layout", m_aMigrationQueue.Count()), LogLevel.NORMAL);
+			GetGame().GetCallqueue().CallLater(TickMigration, 0, true);
+		}
+	}
+
+	/*!
+	    FindFiles callback: queue the owner UID of a file directly in DATA_DIR.
+	*/
+	protected void OnFlatFileFound(string fileName, FileAttribute attributes = 0, string filesystem = string.Empty)
+	{
+		string name = FilePath.StripPath(fileName);
+		if (fileName != DATA_DIR + name)
+			return; // already inside a shard
+
+		string playerUid = FilePath.StripExtension(name);
+		if (playerUid == "" || playerUid == INDEX_NAME || m_MigrationQueued.Contains(playerUid))
+			return;
+
+		m_MigrationQueued.Insert(playerUid);
+		m_aMigrationQueue.Insert(playerUid);
+	}
+
+	/*!
+	    Per-frame tick: move up to MIGRATIONS_PER_FRAME players into their
+	    shard and index them. Stops itself (and queues the index write) when done.
+	*/
+	protected void TickMigration()
+	{
+		for (int i; i < MIGRATIONS_PER_FRAME && !m_aMigrationQueue.IsEmpty(); i++)
+		{
+			string playerUid = m_aMigrationQueue[0];
+			m_aMigrationQueue.RemoveOrdered(0);
+			m_MigrationQueued.RemoveItem(playerUid);
+
+			// Cached players were migrated by Get()
+			if (m_Entries.Contains(playerUid))
+				continue;
+
+			MigrateFlatFiles(playerUid);
+
+			if (!m_Index.Find(playerUid))
+				IndexFromDisk(playerUid);
+		}
+
+		if (m_aMigrationQueue.IsEmpty())
+		{
+			GetGame().GetCallqueue().Remove(TickMigration);
+			m_Writer.EnqueueIndex(INDEX_PATH);
+			Print("BGL: sharded layout migration complete", LogLevel.NORMAL);
+		}
+	}
+
+	/*!
+	    Move a player's flat-layout files into their shard.
+	    A file already present in the shard wins (it was written after sharding);
+	    the flat copy is only deleted once the shard holds the data.
+	*/
+	protected void MigrateFlatFiles(string playerUid)
+	{
+		MigrateFlatFile(string.Format("%1%2.json", DATA_DIR, playerUid), GetPlayerStoragePath(playerUid), playerUid);
+		MigrateFlatFile(string.Format("%1%2.bglb", DATA_DIR, playerUid), GetBinaryStoragePath(playerUid), playerUid);
+		MigrateFlatFile(BGL_GarageJournal.GetPath(DATA_DIR, playerUid), GetJournalPath(playerUid), playerUid);
+	}
+
+	protected void MigrateFlatFile(string flatPath, string shardPath, string playerUid)
+	{
+		if (!FileIO.FileExists(flatPath))
+			return;
+
+		if (!FileIO.FileExists(shardPath))
+		{
+			EnsureShardDir(playerUid);
+			if (!FileIO.CopyFile(flatPath, shardPath))
+			{
+				Print(string.Format("BGL: failed to move %1 into its shard", flatPath), LogLevel.WARNING);
+				return;
+			}
+		}
+
+		FileIO.DeleteFile(flatPath);
+	}
+
+	/*!
+	    Add a player to the index from their files (migration of unindexed players).
+	    Loads the garage without caching it.
+	*/
+	protected void IndexFromDisk(string playerUid)
+	{
+		bool migrate;
+		BGL_PlayerGarageStorageEntity storage = ReadFromDisk(playerUid, migrate);
+		if (!storage)
+			return;
+
+		BGL_GarageJournal.Replay(storage, GetJournalPath(playerUid));
+
+		string path = GetPlayerStoragePath(playerUid);
+		if (!FileIO.FileExists(path))
+			path = GetBinaryStoragePath(playerUid);
+
+		m_Index.SetSnapshot(playerUid, storage.vehicles.Count(), BGL_GarageWriter.GetFileSize(path));
+	}
+}
@@ -0,0 +1,93 @@
+/*!
+    BGL_GarageCheckout
+    -------------------------
+    Server-wide per-vehicle checkout locks.
+
+    Responsibilities
+    - Give one player at a time the right to withdraw a given stored vehicle
+      (garage key + vehicle id). Needed for pooled garages, where several
+      members can request the same vehicle while the first request still
+      waits in BGL_WithdrawalQueue for a spawn pad.
+    - Refuse deletes of a vehicle someone else has checked out.
+
+    Lifetime
+    - Taken when a withdrawal is queued, released when the request leaves
+      the queue (spawned, dropped or replaced) or its garage is torn down.
+    - Locks older than LOCK_TIMEOUT_MS are treated as free, so a lost
+      release cannot pin a vehicle forever.
+
+    Notes
+    - In memory only; a restart releases every lock.
+*/
+class BGL_GarageCheckout
+{
+	static const int LOCK_TIMEOUT_MS = 300000; //!< Stale lock expiry
+
+	protected static ref BGL_GarageCheckout s_Instance;
+
+	protected ref map<string, int> m_Holders = new map<string, int>(); //!< Lock key → holding player id
+	protected ref map<string, int> m_Taken = new map<string, int>();   //!< Lock key → tick the lock was taken
+
+	/*!
+	    Return the server-wide lock table, creating it on first use.
+	*/
+	static BGL_GarageCheckout GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_GarageCheckout();
+
+		return s_Instance;
+	}
+
+	/*!
+	    Take (or refresh) the lock on a vehicle for a player.
+	    \return false if another player holds a live lock
+	*/
+	bool Acquire(string garageKey, int vehicleId, int playerId)
+	{
+		string lockKey = GetLockKey(garageKey, vehicleId);
+		if (IsHeldByOther(lockKey, playerId))
+			return false;
+
+		m_Holders.Set(lockKey, playerId);
+		m_Taken.Set(lockKey, System.GetTickCount());
+		return true;
+	}
+
+	/*!
+	    Release a lock if this player holds it.
+	*/
+	void Release(string garageKey, int vehicleId, int playerId)
+	{
+		string lockKey = GetLockKey(garageKey, vehicleId);
+
+		int holder;
+		if (!m_Holders.Find(lockKey, holder) || holder != playerId)
+			return;
+
+		m_Holders.Remove(lockKey);
+		m_Taken.Remove(lockKey);
+	}
+
+	/*!
+	    True if a player other than playerId holds a live lock on the vehicle.
+	*/
+	bool IsCheckedOutByOther(string garageKey, int vehicleId, int playerId)
+	{
+		return IsHeldByOther(GetLockKey(garageKey, vehicleId), playerId);
+	}
+
+	protected bool IsHeldByOther(string lockKey, int playerId)
+	{
+		int holder;
+		if (!m_Holders.Find(lockKey, holder) || holder == playerId)
+			return false;
+
+		return System.GetTickCount() - m_Taken.Get(lockKey) < LOCK_TIMEOUT_MS;
+	}
+
+	protected string GetLockKey(string garageKey, int vehicleId)
+	{
+		return string.Format("%1#%2", garageKey, vehicleId);
+	}
+}
@@ -0,0 +1,209 @@
+/*!
+    BGL_VehicleSummary
+    -------------------------
+    Compact per-vehicle header sent to the garage menu.
+    Carries only what the list needs; the full inventory and key data are
+    fetched per vehicle on selection (BGL_Client_RequestVehicleDetails).
+
+    Example JSON fragment:
+    { "id": 7, "prefab": "{...}Prefabs/Vehicles/Car/MyCar.et", "item_count": 14 }
+*/
+class BGL_VehicleSummary : JsonApiStruct
+{
+	//! Stable vehicle id (BGL_VehicleStorageEntity.id); addresses the vehicle in RPCs.
+	int id;
+
+	//! Prefab path of the stored vehicle (list label + preview).
+	string prefab;
+
+	//! Total number of stored inventory items (sum of slot counts).
+	int item_count;
+
+	void BGL_VehicleSummary()
+	{
+		RegV("id");
+		RegV("prefab");
+		RegV("item_count");
+	}
+
+	/*!
+	    Build a summary row from a stored vehicle entry.
+	*/
+	static BGL_VehicleSummary FromVehicle(BGL_VehicleStorageEntity vehicle)
+	{
+		BGL_VehicleSummary summary = new BGL_VehicleSummary();
+		summary.id = vehicle.id;
+		summary.prefab = vehicle.prefab;
+
+		foreach (BGL_VehicleInventorySlot slot : vehicle.inventory)
+		{
+			summary.item_count += slot.count;
+		}
+
+		return summary;
+	}
+}
+
+/*!
+    BGL_GarageDeltaOp
+    -------------------------
+    One mutation between two storage revisions.
+    - op:         EBGL_JournalOp (STORE appends `vehicle`; WITHDRAW/DELETE remove `vehicle_id`)
+    - vehicle_id: Vehicle the op applies to
+    - revision:   Storage revision after the op was applied
+*/
+class BGL_GarageDeltaOp : JsonApiStruct
+{
+	int op;
+	int vehicle_id;
+	int revision;
+	ref BGL_VehicleSummary vehicle;
+
+	void BGL_GarageDeltaOp()
+	{
+		RegV("op");
+		RegV("vehicle_id");
+		RegV("revision");
+		RegV("vehicle");
+	}
+}
+
+/*!
+    BGL_GarageDelta
+    -------------------------
+    Open-menu payload of the versioned garage protocol.
+
+    Variants
+    - Up to date:  full = false, ops empty, base_revision == revision
+    - Diff:        full = false, ops bring base_revision up to revision
+    - Full resync: full = true, vehicles holds the whole summary list
+
+    Example JSON:
+    { "garage_key": "<uid>", "base_revision": 4, "revision": 5, "full": false, "vehicles": [],
+      "ops": [ { "op": 0, "vehicle_id": 7, "revision": 5, "vehicle": { "id": 7, "prefab": "..." } } ] }
+*/
+class BGL_GarageDelta : JsonApiStruct
+{
+	string garage_key; //!< Garage this delta applies to (player UID or pool key)
+	int base_revision;
+	int revision;
+	bool full;
+	ref array<ref BGL_VehicleSummary> vehicles;
+	ref array<ref BGL_GarageDeltaOp> ops;
+
+	void BGL_GarageDelta()
+	{
+		RegV("garage_key");
+		RegV("base_revision");
+		RegV("revision");
+		RegV("full");
+		RegV("vehicles");
+		RegV("ops");
+		vehicles = new array<ref BGL_VehicleSummary>();
+		ops = new array<ref BGL_GarageDeltaOp>();
+	}
+}
+
+/*!
+    BGL_GarageMenuPayload
+    -------------------------
+    Open-menu RPC payload: one BGL_GarageDelta per garage the player can
+    open at the sign (personal first, then pools; see BGL_GaragePools).
+*/
+class BGL_GarageMenuPayload : JsonApiStruct
+{
+	ref array<ref BGL_GarageDelta> garages;
+
+	void BGL_GarageMenuPayload()
+	{
+		RegV("garages");
+		garages = new array<ref BGL_GarageDelta>();
+	}
+}
+
+/*!
+    BGL_GarageSummary
+    -------------------------
+    Client-side model of one garage (personal or pooled) at a known storage
+    revision. Kept by the owning SCR_PlayerController across menu opens so
+    the server only needs to send what changed.
+*/
+class BGL_GarageSummary
+{
+	//! Garage key (player UID or pool key).
+	string garageKey;
+
+	//! Storage revision this model reflects (-1 = nothing received yet).
+	int revision = -1;
+
+	//! Summary rows, in server storage order.
+	ref array<ref BGL_VehicleSummary> vehicles = new array<ref BGL_VehicleSummary>();
+
+	/*!
+	    Apply an open-menu delta.
+	    \return false if the delta does not start at this model's revision
+	            (caller should request a full resync)
+	*/
+	bool ApplyDelta(BGL_GarageDelta delta)
+	{
+		if (delta.full)
+		{
+			vehicles = delta.vehicles;
+			revision = delta.revision;
+			return true;
+		}
+
+		if (delta.base_revision != revision)
+			return false;
+
+		foreach (BGL_GarageDeltaOp op : delta.ops)
+		{
+			if (!ApplyOp(op.op, op.vehicle_id, op.vehicle))
+				return false;
+		}
+
+		revision = delta.revision;
+		return true;
+	}
+
+	/*!
+	    Apply a single mutation and advance the revision by one
+	    (mirrors BGL_PlayerGarageStorageEntity on the server).
+	    \return false if no row has vehicleId (remove ops)
+	*/
+	bool ApplyOp(int op, int vehicleId, BGL_VehicleSummary vehicle)
+	{
+		if (op == EBGL_JournalOp.STORE)
+		{
+			if (!vehicle)
+				return false;
+
+			vehicles.Insert(vehicle);
+		}
+		else
+		{
+			int index = FindIndex(vehicleId);
+			if (index < 0)
+				return false;
+
+			vehicles.RemoveOrdered(index);
+		}
+
+		revision++;
+		return true;
+	}
+
+	/*!
+	    Row position of a vehicle id, or -1.
+	*/
+	int FindIndex(int vehicleId)
+	{
+		foreach (int i, BGL_VehicleSummary vehicle : vehicles)
+		{
+			if (vehicle.id == vehicleId)
+				return i;
+		}
+
+		return -1;
+	}
+}
@@ -0,0 +1,230 @@
+/*!
+    BGL_GarageIndexEntry
+    -------------------------
+    Per-player summary kept in the global garage index.
+
+    Fields
+    - uid:           Persistent player UID
+    - vehicle_count: Vehicles currently stored (kept current on every mutation)
+    - modified:      Unix time of the last mutation or snapshot write
+    - size:          Byte size of the player's last written snapshot file
+*/
+class BGL_GarageIndexEntry : JsonApiStruct
+{
+	string uid;
+	int vehicle_count;
+	int modified;
+	int size;
+
+	void BGL_GarageIndexEntry()
+	{
+		RegV("uid");
+		RegV("vehicle_count");
+		RegV("modified");
+		RegV("size");
+	}
+}
+
+/*!
+    BGL_GarageIndex
+    -------------------------
+    Global index over every player garage under $profile:BLG, owned by
+    BGL_GarageCache and saved as $profile:BLG/index.json.
+
+    Responsibilities
+    - Answer per-player questions (vehicle count, last change, file size)
+      without opening the player's file: capacity checks for players whose
+      garage is not cached, and admin tooling (Find/GetUids/Count).
+    - Track whether it has unsaved changes; the cache queues it on
+      BGL_GarageWriter alongside its own flushes, which writes it through
+      a temp file like the snapshots (WriteTo/MarkSaved).
+
+    File format:
+    {
+      "entries": [
+         { "uid": "<uid>", "vehicle_count": 3, "modified": 1735689600, "size": 1204 },
+         { ... }
+      ]
+    }
+
+    Notes
+    - A missing entry means "unknown", not "empty": callers fall back to
+      loading the player's garage.
+*/
+class BGL_GarageIndex : JsonApiStruct
+{
+	//! Serialized entries (rebuilt from m_Entries on save).
+	ref array<ref BGL_GarageIndexEntry> entries;
+
+	protected ref map<string, ref BGL_GarageIndexEntry> m_Entries = new map<string, ref BGL_GarageIndexEntry>(); //!< UID → entry
+	protected bool m_bDirty; //!< Changes not yet saved
+
+	void BGL_GarageIndex()
+	{
+		RegV("entries");
+		entries = new array<ref BGL_GarageIndexEntry>();
+	}
+
+	// =========================================================
+	// Queries
+	// =========================================================
+
+	/*!
+	    Entry for a player, or null if the player is not indexed.
+	*/
+	BGL_GarageIndexEntry Find(string playerUid)
+	{
+		return m_Entries.Get(playerUid);
+	}
+
+	/*!
+	    Collect every indexed UID.
+	*/
+	void GetUids(notnull array<string> outUids)
+	{
+		foreach (string playerUid, BGL_GarageIndexEntry entry : m_Entries)
+		{
+			outUids.Insert(playerUid);
+		}
+	}
+
+	/*!
+	    Number of indexed players.
+	*/
+	int Count()
+	{
+		return m_Entries.Count();
+	}
+
+	// =========================================================
+	// Updates
+	// =========================================================
+
+	/*!
+	    Record a player's current vehicle count (after a mutation).
+	*/
+	void SetVehicleCount(string playerUid, int vehicleCount)
+	{
+		BGL_GarageIndexEntry entry = FindOrCreate(playerUid);
+		entry.vehicle_count = vehicleCount;
+		entry.modified = System.GetUnixTime();
+		m_bDirty = true;
+	}
+
+	/*!
+	    Record a written snapshot: vehicle count and file size.
+	*/
+	void SetSnapshot(string playerUid, int vehicleCount, int size)
+	{
+		BGL_GarageIndexEntry entry = FindOrCreate(playerUid);
+		entry.vehicle_count = vehicleCount;
+		entry.size = size;
+		entry.modified = System.GetUnixTime();
+		m_bDirty = true;
+	}
+
+	/*!
+	    Forget a player (e.g. their files were quarantined).
+	*/
+	void Remove(string playerUid)
+	{
+		if (m_Entries.Contains(playerUid))
+		{
+			m_Entries.Remove(playerUid);
+			m_bDirty = true;
+		}
+	}
+
+	// =========================================================
+	// Persistence
+	// =========================================================
+
+	/*!
+	    Load the index file, replacing the in-memory entries. Falls back to
+	    the writer's temp file when the file is missing or fails to parse
+	    (crash during an atomic replace).
+	    \return false if a file exists but neither parsed (index starts empty)
+	*/
+	bool Load(string path)
+	{
+		m_Entries.Clear();
+		m_bDirty = false;
+
+		string tmpPath = path + BGL_GarageWriter.TMP_SUFFIX;
+		if (!FileIO.FileExists(path) && !FileIO.FileExists(tmpPath))
+			return true;
+
+		if (!LoadFile(path))
+		{
+			if (!LoadFile(tmpPath))
+			{
+				entries.Clear();
+				return false;
+			}
+
+			Print(string.Format("BGL: recovered %1 from %2", path, tmpPath), LogLevel.WARNING);
+			m_bDirty = true; // rewrite the main file on the next flush
+		}
+
+		foreach (BGL_GarageIndexEntry entry : entries)
+		{
+			if (entry && entry.uid)
+				m_Entries.Set(entry.uid, entry);
+		}
+
+		entries.Clear();
+		return true;
+	}
+
+	/*!
+	    True if the index has changes not yet saved.
+	*/
+	bool IsDirty()
+	{
+		return m_bDirty;
+	}
+
+	/*!
+	    Serialize the current entries to a file (BGL_GarageWriter writes
+	    this to a temp file, then replaces the index with it).
+	    \return true if the write succeeded
+	*/
+	bool WriteTo(string path)
+	{
+		foreach (string playerUid, BGL_GarageIndexEntry entry : m_Entries)
+		{
+			entries.Insert(entry);
+		}
+
+		bool saved = SaveToFile(path);
+		entries.Clear();
+		return saved;
+	}
+
+	/*!
+	    Clear the dirty flag once the index file is in place.
+	*/
+	void MarkSaved()
+	{
+		m_bDirty = false;
+	}
+
+	protected bool LoadFile(string path)
+	{
+		entries.Clear();
+		return FileIO.FileExists(path) && LoadFromFile(path);
+	}
+
+	protected BGL_GarageIndexEntry FindOrCreate(string playerUid)
+	{
+		BGL_GarageIndexEntry entry = m_Entries.Get(playerUid);
+		if (!entry)
+		{
+			entry = new BGL_GarageIndexEntry();
+			entry.uid = playerUid;
+			m_Entries.Insert(playerUid, entry);
+		}
+
+		return entry;
+	}
+}
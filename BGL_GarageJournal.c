@@ -0,0 +1,206 @@
+/*!
+    EBGL_JournalOp
+    -------------------------
+    Mutation kinds recorded in a player's garage journal.
+*/
+enum EBGL_JournalOp
+{
+	STORE,    //!< Vehicle appended to the garage (record carries the vehicle)
+	WITHDRAW, //!< Vehicle (by id) spawned back into the world
+	DELETE    //!< Vehicle (by id) scrapped from the menu
+}
+
+/*!
+    BGL_GarageJournalRecord
+    -------------------------
+    One append-only journal line. Serialized as a single compact JSON object.
+
+    Example lines:
+    { "seq": 12, "op": 0, "vehicle_id": 7, "index": -1, "vehicle": { "id": 7, ...vehicle storage entry... } }
+    { "seq": 13, "op": 1, "vehicle_id": 7, "index": -1 }
+
+    Records written before vehicle ids existed carry only "index"; replay
+    still applies them by position.
+*/
+class BGL_GarageJournalRecord : JsonApiStruct
+{
+	//! Monotonic sequence number; compared against the snapshot's journal_seq on replay.
+	int seq;
+
+	//! EBGL_JournalOp value (-1 when the line failed to parse).
+	int op;
+
+	//! Target vehicle id for WITHDRAW/DELETE (0 in legacy records).
+	int vehicle_id;
+
+	//! Legacy target position for WITHDRAW/DELETE (read only; -1 in current records).
+	int index;
+
+	//! Stored vehicle for STORE (null otherwise).
+	ref BGL_VehicleStorageEntity vehicle;
+
+	void BGL_GarageJournalRecord()
+	{
+		RegV("seq");
+		RegV("op");
+		RegV("vehicle_id");
+		RegV("index");
+		RegV("vehicle");
+		op = -1;
+		index = -1;
+	}
+}
+
+/*!
+    BGL_GarageJournal
+    -------------------------
+    Append-only persistence helpers for garage storage (optional backend used by
+    BGL_GarageCache when journal mode is enabled).
+
+    Responsibilities
+    - Append one small record per store/withdraw/delete instead of rewriting the
+      whole player file.
+    - Replay records on top of the JSON snapshot at load time.
+    - Discard the journal once it has been compacted into the snapshot.
+
+    Files
+    - <playerUid>.journal next to the player's snapshot in its
+      $profile:BLG/<shard>/ directory (see BGL_GarageCache)
+
+    Crash safety
+    - Each record carries a sequence number; the snapshot stores the last folded
+      sequence (journal_seq). Records at or below it are skipped, so a crash
+      between writing the snapshot and deleting the journal cannot double-apply.
+    - A torn trailing line fails to parse and ends replay there.
+*/
+class BGL_GarageJournal
+{
+	/*!
+	    Build the journal path for a player.
+	    \param dir       Storage directory (with trailing slash)
+	    \param playerUid Persistent player UID
+	*/
+	static string GetPath(string dir, string playerUid)
+	{
+		return string.Format("%1%2.journal", dir, playerUid);
+	}
+
+	/*!
+	    Apply a mutation to storage and append the matching record.
+	    \param storage Cached storage (mutated in place)
+	    \param path    Journal path
+	    \param record  Record with op/vehicle_id/vehicle set; seq is assigned here
+	    \return true if the record was written
+	*/
+	static bool Append(BGL_PlayerGarageStorageEntity storage, string path, BGL_GarageJournalRecord record)
+	{
+		array<ref BGL_GarageJournalRecord> records = {record};
+		return AppendAll(storage, path, records) == 1;
+	}
+
+	/*!
+	    Apply a batch of mutations and append their records with one file open
+	    (BGL_Component.StoreAll()). Stops at the first record that does not
+	    apply; the records before it stay written and applied.
+	    \return Number of records written
+	*/
+	static int AppendAll(BGL_PlayerGarageStorageEntity storage, string path, notnull array<ref BGL_GarageJournalRecord> records)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.APPEND);
+		if (!file)
+			return 0;
+
+		int written;
+		foreach (BGL_GarageJournalRecord record : records)
+		{
+			record.seq = storage.journal_seq + 1;
+			if (!Apply(storage, record))
+				break;
+
+			record.Pack();
+			file.WriteLine(record.AsString());
+			written++;
+		}
+
+		file.Close();
+		return written;
+	}
+
+	/*!
+	    Replay every unfolded record of a journal onto a loaded snapshot.
+	    \return Number of records applied
+	*/
+	static int Replay(BGL_PlayerGarageStorageEntity storage, string path)
+	{
+		if (!FileIO.FileExists(path))
+			return 0;
+
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return 0;
+
+		int applied;
+		string line;
+		while (file.ReadLine(line) >= 0)
+		{
+			if (line.IsEmpty())
+				continue;
+
+			BGL_GarageJournalRecord record = new BGL_GarageJournalRecord();
+			record.ExpandFromRAW(line);
+			if (record.op < 0)
+				break; // torn tail
+
+			if (record.seq <= storage.journal_seq)
+				continue; // already folded into the snapshot
+
+			if (Apply(storage, record))
+				applied++;
+		}
+
+		file.Close();
+		return applied;
+	}
+
+	/*!
+	    Remove a journal after its records were folded into the snapshot.
+	*/
+	static void Discard(string path)
+	{
+		if (FileIO.FileExists(path))
+			FileIO.DeleteFile(path);
+	}
+
+	/*!
+	    Apply one record to storage and advance journal_seq.
+	    \return false if the record does not fit the current state
+	*/
+	protected static bool Apply(BGL_PlayerGarageStorageEntity storage, BGL_GarageJournalRecord record)
+	{
+		if (record.op == EBGL_JournalOp.STORE)
+		{
+			if (!record.vehicle)
+				return false;
+
+			storage.AddVehicle(record.vehicle);
+		}
+		else if (record.op == EBGL_JournalOp.WITHDRAW || record.op == EBGL_JournalOp.DELETE)
+		{
+			bool removed;
+			if (record.vehicle_id > 0)
+				removed = storage.RemoveVehicle(record.vehicle_id);
+			else
+				removed = storage.RemoveVehicleAt(record.index);
+
+			if (!removed)
+				return false;
+		}
+		else
+		{
+			return false;
+		}
+
+		storage.journal_seq = record.seq;
+		return true;
+	}
+}
@@ -0,0 +1,252 @@
+/*!
+    BGL_GarageMaintenance
+    -------------------------
+    One-shot maintenance pass over every stored garage, run on a (headless)
+    dedicated server started with -bglMaintenance.
+
+    Per garage
+    - Load through BGL_GarageCache (layout migration + journal replay included).
+      Unreadable files are quarantined (<file>.corrupt) by BGL_GarageCache.Quarantine().
+    - Validate: drop vehicles whose prefab is empty or does not load, and
+      inventory slots with an invalid prefab or a non-positive count
+      (with everything stored inside them).
+    - Dedupe inventory slots that share a prefab (MergeDuplicateSlots).
+    - Write back: compacts journals and, with -bglMaintenanceFormat, converts
+      every garage to that format. The write is drained from BGL_GarageWriter
+      right away so its outcome and time are reported per garage.
+    - Evict from the cache so memory stays flat over large stores.
+
+    Command line
+    - -bglMaintenance                    start the pass once the first garage component initializes
+    - -bglMaintenanceFormat=json|binary  snapshot format to write (also sets the server-wide mode)
+    - -bglMaintenanceExit                close the game when the pass completes
+
+    Output
+    - $profile:BLG/maintenance_report.txt: one tab-separated line per garage
+      (uid, status, vehicles, dropped vehicles, dropped slots, merged slots,
+      parse ms, write ms), then totals. Totals are also printed to the log.
+
+    Notes
+    - Script has no worker threads; garages are processed on the main thread
+      within BUDGET_MS per frame, which a headless server turns over quickly.
+    - Invalid-prefab checks go through BGL_PrefabCache, so each distinct
+      prefab is loaded once.
+*/
+class BGL_GarageMaintenance
+{
+	static const float BUDGET_MS = 50.0;  //!< Main-thread time per frame spent on garages
+	static const string REPORT_PATH = "$profile:BLG/maintenance_report.txt";
+
+	protected static ref BGL_GarageMaintenance s_Instance;
+
+	protected ref array<string> m_aUids = {}; //!< Garages still to process
+	protected int m_iTotal;                   //!< Garages found at start
+	protected FileHandle m_Report;            //!< Open report file (null if it failed to open)
+	protected int m_iStartTick;
+
+	// Totals
+	protected int m_iOk;
+	protected int m_iRepaired;
+	protected int m_iQuarantined;
+	protected int m_iFailed;
+	protected int m_iParseMs;
+	protected int m_iWriteMs;
+
+	/*!
+	    Start the pass if the server was launched with -bglMaintenance
+	    (once per session; later calls are ignored).
+	*/
+	static void StartFromCLI()
+	{
+		if (s_Instance || !System.IsCLIParam("bglMaintenance"))
+			return;
+
+		s_Instance = new BGL_GarageMaintenance();
+		s_Instance.Start();
+	}
+
+	// =========================================================
+	// Run
+	// =========================================================
+
+	protected void Start()
+	{
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+
+		string format;
+		if (System.GetCLIParam("bglMaintenanceFormat", format))
+		{
+			format.ToLower();
+			if (format == "binary")
+				cache.SetBinaryMode(true);
+			else if (format == "json")
+				cache.SetBinaryMode(false);
+			else
+				Print(string.Format("BGL: unknown -bglMaintenanceFormat '%1', keeping the configured format", format), LogLevel.WARNING);
+		}
+
+		cache.GetStoredUids(m_aUids);
+		m_iTotal = m_aUids.Count();
+		m_iStartTick = System.GetTickCount();
+
+		m_Report = FileIO.OpenFile(REPORT_PATH, FileMode.WRITE);
+		if (m_Report)
+			m_Report.WriteLine("uid\tstatus\tvehicles\tdropped_vehicles\tdropped_slots\tmerged_slots\tparse_ms\twrite_ms");
+
+		Print(string.Format("BGL: maintenance started for %1 garages", m_iTotal), LogLevel.NORMAL);
+		GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+
+	/*!
+	    Per-frame tick: process garages until BUDGET_MS has elapsed.
+	*/
+	protected void Tick()
+	{
+		int startTick = System.GetTickCount();
+		while (!m_aUids.IsEmpty() && System.GetTickCount() - startTick < BUDGET_MS)
+		{
+			string playerUid = m_aUids[m_aUids.Count() - 1];
+			m_aUids.Remove(m_aUids.Count() - 1);
+			ProcessGarage(playerUid);
+		}
+
+		if (m_aUids.IsEmpty())
+			Finish();
+	}
+
+	protected void Finish()
+	{
+		GetGame().GetCallqueue().Remove(Tick);
+
+		BGL_GarageCache.GetInstance().FlushAll();
+
+		string summary = string.Format("BGL: maintenance done in %1 ms: %2 garages, %3 ok, %4 repaired, %5 quarantined, %6 failed (parse %7 ms, write %8 ms)",
+			System.GetTickCount() - m_iStartTick, m_iTotal, m_iOk, m_iRepaired, m_iQuarantined, m_iFailed, m_iParseMs, m_iWriteMs);
+
+		if (m_Report)
+		{
+			m_Report.WriteLine(summary);
+			m_Report.Close();
+			m_Report = null;
+		}
+
+		Print(summary, LogLevel.NORMAL);
+
+		if (System.IsCLIParam("bglMaintenanceExit"))
+			GetGame().RequestClose();
+	}
+
+	// =========================================================
+	// Per garage
+	// =========================================================
+
+	protected void ProcessGarage(string playerUid)
+	{
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+
+		int tick = System.GetTickCount();
+		BGL_PlayerGarageStorageEntity storage = cache.Get(playerUid);
+		int parseMs = System.GetTickCount() - tick;
+		m_iParseMs += parseMs;
+
+		if (!storage)
+		{
+			string status = "quarantined";
+			if (cache.Quarantine(playerUid))
+				m_iQuarantined++;
+			else
+			{
+				status = "failed";
+				m_iFailed++;
+			}
+
+			WriteReportLine(playerUid, status, 0, 0, 0, 0, parseMs, 0);
+			return;
+		}
+
+		int droppedVehicles;
+		int droppedSlots;
+		int mergedSlots;
+		for (int i = storage.vehicles.Count() - 1; i >= 0; i--)
+		{
+			BGL_VehicleStorageEntity vehicle = storage.vehicles[i];
+			if (!vehicle || !IsValidPrefab(vehicle.prefab))
+			{
+				storage.vehicles.RemoveOrdered(i);
+				droppedVehicles++;
+				continue;
+			}
+
+			droppedSlots += DropInvalidSlots(vehicle);
+			mergedSlots += vehicle.MergeDuplicateSlots();
+		}
+
+		bool repaired = droppedVehicles + droppedSlots + mergedSlots > 0;
+		if (repaired)
+			cache.Put(storage);
+		else
+			cache.MarkDirty(playerUid); // rewrite: compacts the journal, converts the format
+
+		tick = System.GetTickCount();
+		bool written = cache.Compact(playerUid) && cache.DrainWrites();
+		int writeMs = System.GetTickCount() - tick;
+		m_iWriteMs += writeMs;
+
+		cache.Evict(playerUid);
+
+		string status = "ok";
+		if (!written)
+		{
+			status = "failed";
+			m_iFailed++;
+		}
+		else if (repaired)
+		{
+			status = "repaired";
+			m_iRepaired++;
+		}
+		else
+		{
+			m_iOk++;
+		}
+
+		WriteReportLine(playerUid, status, storage.vehicles.Count(), droppedVehicles, droppedSlots, mergedSlots, parseMs, writeMs);
+	}
+
+	/*!
+	    Remove slots with an invalid prefab or a non-positive count, together
+	    with their contents (walked backwards so the tree stays consistent).
+	    \return Number of slots removed
+	*/
+	protected int DropInvalidSlots(BGL_VehicleStorageEntity vehicle)
+	{
+		int dropped;
+		for (int i = vehicle.inventory.Count() - 1; i >= 0; i--)
+		{
+			BGL_VehicleInventorySlot slot = vehicle.inventory[i];
+			if (slot && slot.count > 0 && IsValidPrefab(slot.prefab))
+				continue;
+
+			dropped += vehicle.RemoveSlot(i);
+		}
+
+		return dropped;
+	}
+
+	protected bool IsValidPrefab(ResourceName prefab)
+	{
+		if (prefab.IsEmpty())
+			return false;
+
+		Resource resource = BGL_PrefabCache.GetInstance().Get(prefab);
+		return resource && resource.IsValid();
+	}
+
+	protected void WriteReportLine(string playerUid, string status, int vehicles, int droppedVehicles, int droppedSlots, int mergedSlots, int parseMs, int writeMs)
+	{
+		if (!m_Report)
+			return;
+
+		m_Report.WriteLine(string.Format("%1\t%2\t%3\t%4\t%5\t%6\t%7\t%8", playerUid, status, vehicles, droppedVehicles, droppedSlots, mergedSlots, parseMs, writeMs));
+	}
+}
@@ -0,0 +1,86 @@
+//! Which garage a store goes into (BGL_StoreAction) / a garage key belongs to.
+enum EBGL_GarageScope
+{
+	PERSONAL, //!< The player's own garage (key = player UID)
+	FACTION,  //!< Motor pool shared by the player's faction
+	GROUP     //!< Motor pool shared by the player's group (unit)
+}
+
+/*!
+    BGL_GaragePools
+    -------------------------
+    Garage keys for pooled (shared) garages.
+
+    Every garage, personal or pooled, is a BGL_PlayerGarageStorageEntity in
+    BGL_GarageCache keyed by a string (player_uid holds the key). Personal
+    garages use the player's UID; pools use a prefixed key:
+    - pool_faction_<FactionKey>
+    - pool_group_<GroupID>
+
+    Notes
+    - A pool is loaded once into the shared cache and every member's request
+      mutates that one in-memory copy; script runs on the main thread, so
+      requests against a pool are applied one after another. Per-vehicle
+      exclusivity across frames (queued withdrawals) is BGL_GarageCheckout.
+    - Group ids are assigned by the groups manager per session, so a unit
+      that is recreated with a new id after a restart starts a new pool.
+*/
+class BGL_GaragePools
+{
+	static const string POOL_PREFIX = "pool_";
+	static const string FACTION_PREFIX = "pool_faction_";
+	static const string GROUP_PREFIX = "pool_group_";
+
+	/*!
+	    Garage key for a scope, or empty if the player has no such pool
+	    (no faction / not in a group).
+	*/
+	static string GetGarageKey(EBGL_GarageScope scope, int playerId, string playerUid)
+	{
+		if (scope == EBGL_GarageScope.FACTION)
+		{
+			Faction faction = SCR_FactionManager.SGetPlayerFaction(playerId);
+			if (!faction)
+				return string.Empty;
+
+			return FACTION_PREFIX + faction.GetFactionKey();
+		}
+
+		if (scope == EBGL_GarageScope.GROUP)
+		{
+			SCR_GroupsManagerComponent groupsManager = SCR_GroupsManagerComponent.GetInstance();
+			if (!groupsManager)
+				return string.Empty;
+
+			SCR_AIGroup group = groupsManager.GetPlayerGroup(playerId);
+			if (!group)
+				return string.Empty;
+
+			return GROUP_PREFIX + group.GetGroupID().ToString();
+		}
+
+		return playerUid;
+	}
+
+	/*!
+	    True if the key names a pooled garage.
+	*/
+	static bool IsPool(string garageKey)
+	{
+		return garageKey.StartsWith(POOL_PREFIX);
+	}
+
+	/*!
+	    Short menu label for a garage key.
+	*/
+	static string GetLabel(string garageKey)
+	{
+		if (garageKey.StartsWith(FACTION_PREFIX))
+			return "Faction pool";
+
+		if (garageKey.StartsWith(GROUP_PREFIX))
+			return "Unit pool";
+
+		return "Personal";
+	}
+}
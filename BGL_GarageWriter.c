@@ -0,0 +1,314 @@
+/*!
+    BGL_GarageWriteJob
+    -------------------------
+    One pending snapshot write held by BGL_GarageWriter.
+
+    Fields
+    - m_Storage:      Garage to write; serialized when the write runs, so a
+                      job always writes the latest in-memory state.
+    - m_sPath:        Snapshot file in the active format.
+    - m_sStalePath:   Snapshot file of the other format (removed after the write).
+    - m_sJournalPath: Journal folded by this snapshot (discarded after the write).
+    - m_bBinary:      Write with BGL_GarageBinaryCodec instead of JSON.
+    - m_iQueuedTick:  Tick count when the job was first queued (queue latency).
+*/
+class BGL_GarageWriteJob
+{
+	ref BGL_PlayerGarageStorageEntity m_Storage;
+	string m_sPath;
+	string m_sStalePath;
+	string m_sJournalPath;
+	bool m_bBinary;
+	int m_iQueuedTick;
+}
+
+/*!
+    BGL_GarageWriter
+    -------------------------
+    Deferred snapshot writer owned by BGL_GarageCache. Flushes and
+    compactions queue a job here instead of writing inline, so a pass over
+    many dirty garages (or a slow disk) no longer stalls a single frame.
+
+    Responsibilities
+    - Coalesce: one pending job per UID; queuing a UID that is already
+      pending only refreshes its paths/format and keeps its queue position.
+    - Drain the queue WRITES_PER_FRAME jobs per frame.
+    - Replace each snapshot crash-safely (WriteAtomic), then remove the stale
+      other-format file, discard the folded journal and update the index.
+    - Serve pending garages back to the cache (GetPending) so a garage
+      evicted before its write lands is not reloaded from an older file.
+    - Write the garage index (EnqueueIndex) with the same temp-file replace,
+      in the frame budget left after snapshot jobs.
+    - Flush barrier (Drain) for shutdown and maintenance.
+
+    Crash safety
+    - The snapshot is written to <file>.tmp, the old file is removed and the
+      temp file copied over it, then the temp file is deleted. Script has no
+      rename, so a crash can leave only the temp file or a torn final file;
+      BGL_GarageCache loads <file>.tmp whenever <file> is missing or fails
+      to parse (see BGL_GarageCache.LoadSnapshot).
+    - The journal is only discarded after the snapshot is in place.
+
+    Notes
+    - Script has no worker threads: writes still run on the main thread,
+      but bounded per frame and off the store/withdraw paths.
+    - A failed write keeps its job at the back of the queue and is retried.
+*/
+class BGL_GarageWriter
+{
+	static const int WRITES_PER_FRAME = 2;      //!< Snapshot writes per frame
+	static const string TMP_SUFFIX = ".tmp";    //!< Temp file suffix for atomic replace
+
+	protected ref map<string, ref BGL_GarageWriteJob> m_Jobs = new map<string, ref BGL_GarageWriteJob>(); //!< UID → pending job
+	protected ref array<string> m_aOrder = {}; //!< Pending UIDs, FIFO
+	protected BGL_GarageIndex m_Index;         //!< Index updated after each write (owned by the cache)
+	protected string m_sIndexPath;             //!< Index file to write ("" until EnqueueIndex)
+	protected bool m_bIndexPending;            //!< Index write requested
+	protected bool m_bTicking;                 //!< Per-frame tick scheduled
+
+	void BGL_GarageWriter(BGL_GarageIndex index)
+	{
+		m_Index = index;
+	}
+
+	void ~BGL_GarageWriter()
+	{
+		if (m_bTicking && GetGame())
+			GetGame().GetCallqueue().Remove(Tick);
+	}
+
+	// =========================================================
+	// Public API
+	// =========================================================
+
+	/*!
+	    Queue a snapshot write, coalescing with a pending write for the same UID.
+	*/
+	void Enqueue(notnull BGL_GarageWriteJob job)
+	{
+		string playerUid = job.m_Storage.player_uid;
+
+		BGL_GarageWriteJob pending = m_Jobs.Get(playerUid);
+		if (pending)
+		{
+			job.m_iQueuedTick = pending.m_iQueuedTick;
+			m_Jobs.Set(playerUid, job);
+			BGL_Metrics.Count("writer_coalesced_total");
+			return;
+		}
+
+		job.m_iQueuedTick = System.GetTickCount();
+		m_Jobs.Insert(playerUid, job);
+		m_aOrder.Insert(playerUid);
+		BGL_Metrics.Observe("writer_queue_depth", m_aOrder.Count());
+		StartTick();
+	}
+
+	/*!
+	    Queue a write of the garage index (no-op at write time if it has no
+	    unsaved changes). Runs after pending snapshot jobs in the same frame
+	    budget.
+	*/
+	void EnqueueIndex(string path)
+	{
+		m_sIndexPath = path;
+		m_bIndexPending = true;
+		StartTick();
+	}
+
+	/*!
+	    Garage waiting to be written for a UID, or null if none is pending.
+	*/
+	BGL_PlayerGarageStorageEntity GetPending(string playerUid)
+	{
+		BGL_GarageWriteJob job = m_Jobs.Get(playerUid);
+		if (!job)
+			return null;
+
+		return job.m_Storage;
+	}
+
+	/*!
+	    Drop a pending write (e.g. the garage's files were quarantined).
+	*/
+	void Cancel(string playerUid)
+	{
+		if (!m_Jobs.Contains(playerUid))
+			return;
+
+		m_Jobs.Remove(playerUid);
+		m_aOrder.RemoveItemOrdered(playerUid);
+	}
+
+	/*!
+	    Number of pending writes.
+	*/
+	int Count()
+	{
+		return m_aOrder.Count();
+	}
+
+	/*!
+	    Flush barrier: write every pending job now, then a pending index write.
+	    \return true if the queue is empty afterwards (failed jobs stay queued)
+	*/
+	bool Drain()
+	{
+		int remaining = m_aOrder.Count();
+		while (remaining > 0)
+		{
+			WriteNext();
+			remaining--;
+		}
+
+		if (m_bIndexPending)
+			WriteIndex();
+
+		return m_aOrder.IsEmpty() && !m_bIndexPending;
+	}
+
+	/*!
+	    Byte size of a file (0 if it cannot be opened).
+	*/
+	static int GetFileSize(string path)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return 0;
+
+		int size = file.GetLength();
+		file.Close();
+		return size;
+	}
+
+	// =========================================================
+	// Writing
+	// =========================================================
+
+	protected void StartTick()
+	{
+		if (m_bTicking)
+			return;
+
+		m_bTicking = true;
+		GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+
+	/*!
+	    Per-frame tick: write up to WRITES_PER_FRAME jobs, then the index if
+	    budget is left; stop when nothing is pending.
+	*/
+	protected void Tick()
+	{
+		int i;
+		for (; i < WRITES_PER_FRAME && !m_aOrder.IsEmpty(); i++)
+		{
+			WriteNext();
+		}
+
+		if (i < WRITES_PER_FRAME && m_bIndexPending)
+			WriteIndex();
+
+		if (m_aOrder.IsEmpty() && !m_bIndexPending)
+		{
+			GetGame().GetCallqueue().Remove(Tick);
+			m_bTicking = false;
+		}
+	}
+
+	/*!
+	    Write the index to <path>.tmp, then replace <path> with it.
+	    A failed write stays pending and is retried next frame.
+	*/
+	protected void WriteIndex()
+	{
+		if (!m_Index.IsDirty())
+		{
+			m_bIndexPending = false;
+			return;
+		}
+
+		int tick = System.GetTickCount();
+		string tmpPath = m_sIndexPath + TMP_SUFFIX;
+		if (!m_Index.WriteTo(tmpPath) || !ReplaceWithTmp(tmpPath, m_sIndexPath))
+		{
+			Print(string.Format("BGL: failed to write garage index %1, retrying", m_sIndexPath), LogLevel.WARNING);
+			BGL_Metrics.Count("writer_index_failed_total");
+			return;
+		}
+
+		BGL_Metrics.Lap("writer_index_ms", tick);
+		m_Index.MarkSaved();
+		m_bIndexPending = false;
+	}
+
+	/*!
+	    Write the oldest pending job; on failure it moves to the back of the queue.
+	*/
+	protected void WriteNext()
+	{
+		string playerUid = m_aOrder[0];
+		m_aOrder.RemoveOrdered(0);
+		BGL_GarageWriteJob job = m_Jobs.Get(playerUid);
+
+		int tick = System.GetTickCount();
+		if (!WriteAtomic(job))
+		{
+			Print(string.Format("BGL: failed to write garage %1, retrying", job.m_sPath), LogLevel.WARNING);
+			BGL_Metrics.Count("writer_failed_total");
+			m_aOrder.Insert(playerUid);
+			return;
+		}
+
+		BGL_Metrics.Lap("writer_write_ms", tick);
+		BGL_Metrics.Lap("writer_queue_latency_ms", job.m_iQueuedTick);
+		m_Jobs.Remove(playerUid);
+
+		if (FileIO.FileExists(job.m_sStalePath))
+			FileIO.DeleteFile(job.m_sStalePath);
+
+		BGL_GarageJournal.Discard(job.m_sJournalPath);
+		m_Index.SetSnapshot(playerUid, job.m_Storage.vehicles.Count(), GetFileSize(job.m_sPath));
+	}
+
+	/*!
+	    Write the snapshot to <path>.tmp, then replace <path> with it.
+	    \return false if any step failed (<path> or <path>.tmp still holds a full snapshot)
+	*/
+	protected bool WriteAtomic(BGL_GarageWriteJob job)
+	{
+		string tmpPath = job.m_sPath + TMP_SUFFIX;
+
+		bool saved;
+		if (job.m_bBinary)
+			saved = BGL_GarageBinaryCodec.SaveToFile(job.m_Storage, tmpPath);
+		else
+			saved = job.m_Storage.SaveToFile(tmpPath);
+
+		if (!saved)
+		{
+			if (FileIO.FileExists(tmpPath))
+				FileIO.DeleteFile(tmpPath);
+
+			return false;
+		}
+
+		return ReplaceWithTmp(tmpPath, job.m_sPath);
+	}
+
+	/*!
+	    Replace path with a fully written temp file.
+	    \return false if a step failed (path or tmpPath still holds a full copy)
+	*/
+	protected bool ReplaceWithTmp(string tmpPath, string path)
+	{
+		if (FileIO.FileExists(path) && !FileIO.DeleteFile(path))
+			return false;
+
+		if (!FileIO.CopyFile(tmpPath, path))
+			return false; // the temp file is kept; loads fall back to it
+
+		FileIO.DeleteFile(tmpPath);
+		return true;
+	}
+}
@@ -11,7 +11,13 @@
         • Owner entity ID (for tracking the garage sign/prefab)
         • BGL_Component reference
         • Player UID
-        • Player’s garage storage data (loaded from file)
+    - The controller sends the garage as a delta against what the client
+      already holds (see BGL_GarageDelta).
+    - The menu lists the player's personal garage together with the pooled
+      garages enabled on the component (BGL_Component.GetAccessibleGarages).
+    - Starts warming the prefabs of every listed garage's vehicles and their
+      items (BGL_PrefabCache) so a withdrawal from this menu spawns from
+      resident resources.
 
     Usage
     - Attach to a prefab (e.g., garage sign / terminal) to allow players to
@@ -33,7 +39,8 @@ class BGL_GetAction : ScriptedUserAction
 	      - Obtain BackendApi and derive the player’s persistent UID.
 	      - Locate BGL_Component on the interacted entity.
 	      - Call playerController.BGL_OpenMenu(...) to open the garage UI
-	        with context (signId, bgl reference, playerUid, loaded storage).
+	        with context (signId, bgl reference, playerUid).
+	      - Queue prefab preloading for the vehicles of every listed garage.
 
 	    \param pOwnerEntity The entity owning this action (e.g., garage terminal).
 	    \param pUserEntity  The entity controlled by the player performing the action.
@@ -58,14 +65,22 @@ class BGL_GetAction : ScriptedUserAction
 
 		// Locate garage component
 		BGL_Component bgl = BGL_Component.Cast(pOwnerEntity.FindComponent(BGL_Component));
+		BGL_GarageCache.GetInstance().BindPlayer(playerId, playerUid);
 
 		// Request UI open (menu is spawned client-side via controller RPC)
         playerController.BGL_OpenMenu(
 			pOwnerEntity.GetID(),      // sign / terminal entity ID
 			bgl,                       // garage logic component
-			playerUid,                 // persistent player UID
-			bgl.LoadPlayerGarageData(playerUid) // player storage payload
+			playerUid                  // persistent player UID
 		);
+
+		// Warm vehicle/item prefabs while the player browses the menu
+		array<string> garageKeys = {};
+		bgl.GetAccessibleGarages(playerId, playerUid, garageKeys);
+		foreach (string garageKey : garageKeys)
+		{
+			BGL_PrefabCache.GetInstance().PreloadGarage(bgl.LoadPlayerGarageData(garageKey));
+		}
 	}
 
 	/*!
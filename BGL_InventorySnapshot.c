@@ -0,0 +1,84 @@
+/*!
+    BGL_InventorySnapshot
+    -------------------------
+    Captures a vehicle's inventory as a tree: every item with the storage
+    and slot it sits in, including items inside containers (a backpack in
+    the trunk) and attachments, which are storages of their parent item.
+
+    Layout (BGL_VehicleStorageEntity.inventory)
+    - Nodes are stored flat in pre-order: a container comes before its
+      contents, so node.parent always points to an earlier node.
+    - parent:  index of the containing node, -1 for the vehicle itself
+    - storage: index of the storage on that parent (GetStorages order)
+    - slot:    slot index inside that storage
+    - count:   1 per tree node
+
+    Notes
+    - Storages are enumerated as the BaseInventoryStorageComponents of an
+      entity in component order, which is fixed per prefab; rehydration
+      resolves the same indices on the spawned entities.
+    - Slots written before this format have parent/storage/slot = -1 and a
+      count per prefab; they are restored through the inventory search.
+*/
+class BGL_InventorySnapshot
+{
+	/*!
+	    Capture every item stored in the vehicle.
+	    \param[out] outSlots Pre-order nodes (appended)
+	    \return false if a weapon was found (vehicles carrying weapons are refused)
+	*/
+	static bool Capture(IEntity vehicle, notnull array<ref BGL_VehicleInventorySlot> outSlots)
+	{
+		return CaptureEntity(vehicle, -1, outSlots);
+	}
+
+	/*!
+	    Storages of an entity, in the order used by the snapshot indices.
+	*/
+	static void GetStorages(IEntity entity, notnull array<BaseInventoryStorageComponent> outStorages)
+	{
+		array<Managed> components = {};
+		entity.FindComponents(BaseInventoryStorageComponent, components);
+		foreach (Managed component : components)
+		{
+			outStorages.Insert(BaseInventoryStorageComponent.Cast(component));
+		}
+	}
+
+	protected static bool CaptureEntity(IEntity entity, int parentIndex, notnull array<ref BGL_VehicleInventorySlot> outSlots)
+	{
+		array<BaseInventoryStorageComponent> storages = {};
+		GetStorages(entity, storages);
+
+		foreach (int storageIndex, BaseInventoryStorageComponent storage : storages)
+		{
+			int slotCount = storage.GetSlotsCount();
+			for (int slotIndex; slotIndex < slotCount; slotIndex++)
+			{
+				InventoryStorageSlot storageSlot = storage.GetSlot(slotIndex);
+				if (!storageSlot)
+					continue;
+
+				IEntity item = storageSlot.GetAttachedEntity();
+				if (!item)
+					continue;
+
+				if (item.FindComponent(WeaponComponent))
+					return false;
+
+				BGL_VehicleInventorySlot node = new BGL_VehicleInventorySlot();
+				node.prefab = item.GetPrefabData().GetPrefabName();
+				node.count = 1;
+				node.parent = parentIndex;
+				node.storage = storageIndex;
+				node.slot = slotIndex;
+				outSlots.Insert(node);
+
+				if (!CaptureEntity(item, outSlots.Count() - 1, outSlots))
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,104 @@
+/*!
+    BGL_KeyIndex
+    -------------------------
+    Key id → CarKey item index built from one pass over a player's inventory.
+
+    Responsibilities
+    - Recognize CarKey items by their prefab data (pointer compare after the
+      first match) instead of comparing prefab name strings per item.
+    - Give O(1) membership tests for vehicle key ids and the id list to resolve
+      through BGL_VehicleKeyRegistry.
+    - Give direct access to the matched key item for removal after a store.
+
+    Notes
+    - The CarKey prefab data is resolved once per session from
+      BGL_Component.CAR_KEY_PREFAB; BGL_PrefabCache keeps the prefab resident.
+*/
+class BGL_KeyIndex
+{
+	protected static EntityPrefabData s_CarKeyPrefabData; //!< Resolved CarKey prefab data (null until first seen)
+
+	protected ref map<string, IEntity> m_Keys = new map<string, IEntity>(); //!< Key id → key item
+
+	/*!
+	    Index every CarKey item with a non-empty id.
+	    \param items Player inventory items (single pass)
+	*/
+	void Build(notnull array<IEntity> items)
+	{
+		m_Keys.Clear();
+
+		foreach (IEntity item : items)
+		{
+			if (!IsCarKey(item))
+				continue;
+
+			Key_LockComponent keyLock = Key_LockComponent.Cast(item.FindComponent(Key_LockComponent));
+			if (!keyLock)
+				continue;
+
+			string keyId = keyLock.myID;
+			if (keyId && keyId != "")
+				m_Keys.Set(keyId, item);
+		}
+	}
+
+	/*!
+	    True if the player holds a key with this id.
+	*/
+	bool Contains(string keyId)
+	{
+		return m_Keys.Contains(keyId);
+	}
+
+	/*!
+	    Key item for an id, or null.
+	*/
+	IEntity Find(string keyId)
+	{
+		return m_Keys.Get(keyId);
+	}
+
+	/*!
+	    Collect every indexed key id.
+	*/
+	void GetKeyIds(notnull array<string> outIds)
+	{
+		foreach (string keyId, IEntity item : m_Keys)
+		{
+			outIds.Insert(keyId);
+		}
+	}
+
+	/*!
+	    Number of indexed keys.
+	*/
+	int Count()
+	{
+		return m_Keys.Count();
+	}
+
+	/*!
+	    True if item is a CarKey.
+	    Compares cached prefab data by reference; the name compare only runs
+	    until the first CarKey has been seen.
+	*/
+	static bool IsCarKey(IEntity item)
+	{
+		if (!item)
+			return false;
+
+		EntityPrefabData prefabData = item.GetPrefabData();
+		if (!prefabData)
+			return false;
+
+		if (s_CarKeyPrefabData)
+			return prefabData == s_CarKeyPrefabData;
+
+		if (prefabData.GetPrefabName() != BGL_Component.CAR_KEY_PREFAB)
+			return false;
+
+		s_CarKeyPrefabData = prefabData;
+		return true;
+	}
+}
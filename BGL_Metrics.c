@@ -0,0 +1,177 @@
+/*!
+    BGL_Histogram
+    -------------------------
+    Fixed power-of-two histogram: bucket k counts observations <= 2^k
+    (k = 0..MAX_EXPONENT), plus an overflow bucket. Works for both
+    millisecond timings and byte sizes without per-metric configuration.
+*/
+class BGL_Histogram
+{
+	static const int MAX_EXPONENT = 20; //!< Largest finite bound: 2^20
+
+	ref array<int> m_aBuckets = {}; //!< Non-cumulative counts; last entry is +Inf
+	int m_iCount;
+	float m_fSum;
+	float m_fMax;
+
+	void BGL_Histogram()
+	{
+		for (int k; k <= MAX_EXPONENT + 1; k++)
+		{
+			m_aBuckets.Insert(0);
+		}
+	}
+
+	void Observe(float value)
+	{
+		int k;
+		int bound = 1;
+		while (k <= MAX_EXPONENT && value > bound)
+		{
+			k++;
+			bound = bound << 1;
+		}
+
+		m_aBuckets[k] = m_aBuckets[k] + 1;
+		m_iCount++;
+		m_fSum += value;
+		if (value > m_fMax)
+			m_fMax = value;
+	}
+}
+
+/*!
+    BGL_Metrics
+    -------------------------
+    Server-wide timings and counters for the garage hot paths.
+
+    Responsibilities
+    - Histograms per phase of BGL_Component.Store()/LoadCar() and per
+      controller RPC payload (see the metric names used at the call sites).
+    - Counters for outcomes (stored, refused, spawned, ...).
+    - Periodic dump in Prometheus text format to $profile:BLG/metrics.prom,
+      overwritten each interval so a scraper (e.g. node_exporter textfile
+      collector) can pick it up.
+
+    Usage
+        int tick = System.GetTickCount();
+        ... phase ...
+        tick = BGL_Metrics.Lap("store_key_scan_ms", tick);
+
+    Cost
+    - Disabled (default): every call is one static bool check.
+    - Enabled: a map lookup and a few integer ops per observation; file I/O
+      only on the dump interval.
+
+    Notes
+    - Enabled by BGL_Component.m_bMetrics (server only).
+    - Timings use System.GetTickCount() (1 ms resolution): sub-millisecond
+      phases land in the first bucket; _sum / _count still give their mean.
+*/
+class BGL_Metrics
+{
+	static const string DUMP_PATH = "$profile:BLG/metrics.prom";
+
+	protected static bool s_bEnabled;
+	protected static ref BGL_Metrics s_Instance;
+
+	protected ref map<string, ref BGL_Histogram> m_Histograms = new map<string, ref BGL_Histogram>();
+	protected ref map<string, int> m_Counters = new map<string, int>();
+
+	/*!
+	    Start collecting and dumping every dumpIntervalS seconds (idempotent).
+	*/
+	static void Enable(int dumpIntervalS)
+	{
+		if (s_bEnabled)
+			return;
+
+		s_bEnabled = true;
+		s_Instance = new BGL_Metrics();
+		GetGame().GetCallqueue().CallLater(s_Instance.Dump, Math.Max(1, dumpIntervalS) * 1000, true);
+	}
+
+	static bool IsEnabled()
+	{
+		return s_bEnabled;
+	}
+
+	/*!
+	    Record one observation in a histogram.
+	*/
+	static void Observe(string name, float value)
+	{
+		if (!s_bEnabled)
+			return;
+
+		BGL_Histogram histogram = s_Instance.m_Histograms.Get(name);
+		if (!histogram)
+		{
+			histogram = new BGL_Histogram();
+			s_Instance.m_Histograms.Insert(name, histogram);
+		}
+
+		histogram.Observe(value);
+	}
+
+	/*!
+	    Record the time since startTick in a histogram.
+	    \return Current tick, to chain consecutive phases
+	*/
+	static int Lap(string name, int startTick)
+	{
+		int now = System.GetTickCount();
+		if (s_bEnabled)
+			Observe(name, now - startTick);
+
+		return now;
+	}
+
+	/*!
+	    Add to a counter.
+	*/
+	static void Count(string name, int amount = 1)
+	{
+		if (!s_bEnabled)
+			return;
+
+		s_Instance.m_Counters.Set(name, s_Instance.m_Counters.Get(name) + amount);
+	}
+
+	/*!
+	    Write every metric to DUMP_PATH (cumulative since enable).
+	*/
+	protected void Dump()
+	{
+		FileHandle file = FileIO.OpenFile(DUMP_PATH, FileMode.WRITE);
+		if (!file)
+			return;
+
+		foreach (string name, int value : m_Counters)
+		{
+			file.WriteLine(string.Format("# TYPE bgl_%1 counter", name));
+			file.WriteLine(string.Format("bgl_%1 %2", name, value));
+		}
+
+		foreach (string name, BGL_Histogram histogram : m_Histograms)
+		{
+			file.WriteLine(string.Format("# TYPE bgl_%1 histogram", name));
+
+			int cumulative;
+			int bound = 1;
+			for (int k; k <= BGL_Histogram.MAX_EXPONENT; k++)
+			{
+				cumulative += histogram.m_aBuckets[k];
+				file.WriteLine(string.Format("bgl_%1_bucket{le=\"%2\"} %3", name, bound, cumulative));
+				bound = bound << 1;
+			}
+
+			file.WriteLine(string.Format("bgl_%1_bucket{le=\"+Inf\"} %2", name, histogram.m_iCount));
+			file.WriteLine(string.Format("bgl_%1_sum %2", name, histogram.m_fSum));
+			file.WriteLine(string.Format("bgl_%1_count %2", name, histogram.m_iCount));
+			file.WriteLine(string.Format("bgl_%1_max %2", name, histogram.m_fMax));
+		}
+
+		file.Close();
+	}
+}
@@ -14,9 +14,25 @@
       player’s storage entry.
     - Always initializes `vehicles` as a valid array (empty if no vehicles yet).
 
+    Vehicle ids
+    - Every entry carries a stable id (BGL_VehicleStorageEntity.id), assigned
+      from next_vehicle_id on AddVehicle and never reused, so clients, RPCs and
+      journal records address vehicles by id instead of array position.
+    - Files written before ids existed get ids on load (AssignMissingIds).
+
+    Backend sync (remote storage backends, see BGL_StorageBackend)
+    - backend_version is the remote copy's version this garage was read from
+      or last committed as; commits are accepted only against it.
+    - backend_revision != revision means local changes not yet committed.
+
     File format (per player):
     {
       "player_uid": "<uid string>",
+      "revision": <bumped on every add/remove>,
+      "journal_seq": <last journal record folded into this snapshot>,
+      "next_vehicle_id": <last vehicle id handed out>,
+      "backend_version": <storage backend version this garage is based on>,
+      "backend_revision": <revision last committed to the storage backend>,
       "vehicles": [
          { ...vehicle storage entry... },
          { ... }
@@ -31,6 +47,21 @@ class BGL_PlayerGarageStorageEntity : JsonApiStruct
 	//! Collection of this player’s stored vehicles.
 	ref array<ref BGL_VehicleStorageEntity> vehicles;
 
+	//! Storage revision; bumped by every AddVehicle/RemoveVehicle (see BGL_GarageDelta).
+	int revision;
+
+	//! Sequence of the last journal record folded into this snapshot (see BGL_GarageJournal).
+	int journal_seq;
+
+	//! Last vehicle id handed out (ids start at 1).
+	int next_vehicle_id;
+
+	//! Remote version this garage is based on (optimistic concurrency, see BGL_StorageBackend).
+	int backend_version;
+
+	//! Revision last committed to the storage backend (== revision when in sync).
+	int backend_revision;
+
 	/*!
 	    Constructor
 	    - Registers members with JSON API (RegV).
@@ -40,6 +71,106 @@ class BGL_PlayerGarageStorageEntity : JsonApiStruct
 	{
 		RegV("player_uid");
 		RegV("vehicles");
+		RegV("revision");
+		RegV("journal_seq");
+		RegV("next_vehicle_id");
+		RegV("backend_version");
+		RegV("backend_revision");
 		vehicles = new array<ref BGL_VehicleStorageEntity>();
 	}
+
+	/*!
+	    Append a vehicle entry and bump the revision.
+	    Assigns the next id if the entry has none (an entry replayed from the
+	    journal keeps the id it was stored with).
+	*/
+	void AddVehicle(BGL_VehicleStorageEntity vehicle)
+	{
+		if (vehicle.id <= 0)
+			vehicle.id = ++next_vehicle_id;
+		else
+			next_vehicle_id = Math.Max(next_vehicle_id, vehicle.id);
+
+		vehicles.Insert(vehicle);
+		revision++;
+	}
+
+	/*!
+	    Stored vehicle with this id, or null.
+	*/
+	BGL_VehicleStorageEntity FindVehicle(int vehicleId)
+	{
+		int index = FindVehicleIndex(vehicleId);
+		if (index < 0)
+			return null;
+
+		return vehicles[index];
+	}
+
+	/*!
+	    Array position of the vehicle with this id, or -1.
+	*/
+	int FindVehicleIndex(int vehicleId)
+	{
+		foreach (int i, BGL_VehicleStorageEntity vehicle : vehicles)
+		{
+			if (vehicle.id == vehicleId)
+				return i;
+		}
+
+		return -1;
+	}
+
+	/*!
+	    Remove the vehicle with this id, keeping the order of the remaining
+	    entries, and bump the revision.
+	    \return false if no vehicle has this id
+	*/
+	bool RemoveVehicle(int vehicleId)
+	{
+		return RemoveVehicleAt(FindVehicleIndex(vehicleId));
+	}
+
+	/*!
+	    Remove a vehicle entry by array position (legacy journal records only)
+	    and bump the revision.
+	    \return false if index is out of range
+	*/
+	bool RemoveVehicleAt(int index)
+	{
+		if (index < 0 || index >= vehicles.Count())
+			return false;
+
+		vehicles.RemoveOrdered(index);
+		revision++;
+		return true;
+	}
+
+	/*!
+	    Give every entry without a valid id (or with a duplicate) a fresh one.
+	    \return Number of ids assigned (caller persists the change if > 0)
+	*/
+	int AssignMissingIds()
+	{
+		set<int> seen = new set<int>();
+		foreach (BGL_VehicleStorageEntity vehicle : vehicles)
+		{
+			if (vehicle.id > next_vehicle_id)
+				next_vehicle_id = vehicle.id;
+		}
+
+		int assigned;
+		foreach (BGL_VehicleStorageEntity vehicle : vehicles)
+		{
+			if (vehicle.id <= 0 || seen.Contains(vehicle.id))
+			{
+				vehicle.id = ++next_vehicle_id;
+				assigned++;
+			}
+
+			seen.Insert(vehicle.id);
+		}
+
+		return assigned;
+	}
 }
@@ -0,0 +1,130 @@
+/*!
+    BGL_PrefabCache
+    -------------------------
+    Server-wide cache of warmed prefab resources for garage spawns.
+
+    Responsibilities
+    - Accept preload requests (e.g. when a player opens the garage menu) and
+      resolve them a few per frame in the background, so the first spawn of an
+      uncached vehicle type does not pay the load inside the spawn frame.
+    - Hold a Resource handle for every warmed prefab so vehicle and item
+      prefabs stay resident for LoadCar() and inventory rehydration.
+    - Serve Get() from the warmed handles, falling back to a synchronous load
+      (which is then cached) when a prefab was not warmed yet.
+
+    Notes
+    - Script has no asynchronous Resource API; "background" here means
+      spread over frames (PRELOADS_PER_FRAME loads per frame via the call queue).
+    - Prefab variety on a server is small, so handles are kept for the session.
+*/
+class BGL_PrefabCache
+{
+	static const int PRELOADS_PER_FRAME = 2; //!< Resource.Load calls per frame while warming
+
+	protected static ref BGL_PrefabCache s_Instance;
+
+	protected ref map<ResourceName, ref Resource> m_Loaded = new map<ResourceName, ref Resource>(); //!< Warmed handles
+	protected ref array<ResourceName> m_aPending = {};                                              //!< Preload queue (FIFO)
+	protected ref set<ResourceName> m_Queued = new set<ResourceName>();                             //!< Dedupe for m_aPending
+
+	/*!
+	    Return the server-wide prefab cache, creating it on first use.
+	*/
+	static BGL_PrefabCache GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_PrefabCache();
+
+		return s_Instance;
+	}
+
+	// =========================================================
+	// Public API
+	// =========================================================
+
+	/*!
+	    Queue a prefab for background warming (no-op if warm or queued).
+	*/
+	void Preload(ResourceName prefab)
+	{
+		if (prefab.IsEmpty() || m_Loaded.Contains(prefab) || m_Queued.Contains(prefab))
+			return;
+
+		m_Queued.Insert(prefab);
+		m_aPending.Insert(prefab);
+
+		if (m_aPending.Count() == 1)
+			GetGame().GetCallqueue().CallLater(TickPreload, 0, true);
+	}
+
+	/*!
+	    Queue every prefab a garage withdrawal can spawn: each stored vehicle,
+	    its inventory items and the CarKey.
+	*/
+	void PreloadGarage(BGL_PlayerGarageStorageEntity storage)
+	{
+		if (!storage || storage.vehicles.IsEmpty())
+			return;
+
+		Preload(BGL_Component.CAR_KEY_PREFAB);
+
+		foreach (BGL_VehicleStorageEntity vehicle : storage.vehicles)
+		{
+			Preload(vehicle.prefab);
+
+			foreach (BGL_VehicleInventorySlot slot : vehicle.inventory)
+			{
+				Preload(slot.prefab);
+			}
+		}
+	}
+
+	/*!
+	    Return a loaded resource for prefab.
+	    Uses the warmed handle when ready; otherwise loads now and caches it.
+	*/
+	Resource Get(ResourceName prefab)
+	{
+		Resource resource = m_Loaded.Get(prefab);
+		if (resource)
+			return resource;
+
+		return LoadNow(prefab);
+	}
+
+	// =========================================================
+	// Internals
+	// =========================================================
+
+	/*!
+	    Per-frame tick: warm up to PRELOADS_PER_FRAME queued prefabs.
+	    Stops itself when the queue is empty.
+	*/
+	protected void TickPreload()
+	{
+		for (int i; i < PRELOADS_PER_FRAME && !m_aPending.IsEmpty(); i++)
+		{
+			ResourceName prefab = m_aPending[0];
+			m_aPending.RemoveOrdered(0);
+			m_Queued.RemoveItem(prefab);
+
+			if (!m_Loaded.Contains(prefab))
+				LoadNow(prefab);
+		}
+
+		if (m_aPending.IsEmpty())
+			GetGame().GetCallqueue().Remove(TickPreload);
+	}
+
+	/*!
+	    Load a prefab synchronously and keep the handle if valid.
+	*/
+	protected Resource LoadNow(ResourceName prefab)
+	{
+		Resource resource = Resource.Load(prefab);
+		if (resource && resource.IsValid())
+			m_Loaded.Set(prefab, resource);
+
+		return resource;
+	}
+}
@@ -0,0 +1,185 @@
+/*!
+    BGL_RehydrationJob
+    -------------------------
+    Frame-budgeted restore of a withdrawn vehicle's inventory.
+    Created by BGL_Component.LoadCar() right after the vehicle spawns and
+    advanced by the component's rehydration tick until Step() reports done.
+
+    Phases
+    1) Delete the prefab's default items (one per unit of work)
+    2) Spawn every stored item unit (one per unit of work):
+       - placed entries (item tree, BGL_InventorySnapshot) go straight into
+         their recorded storage and slot on the vehicle or on their already
+         restored container, whose default contents are cleared first
+       - legacy entries, and entries whose target is gone or taken, fall
+         back to the inventory manager's insertion search
+
+    Budget
+    - Step() stops after maxItems units or once budgetMs has elapsed,
+      whichever comes first; the remaining work continues next tick.
+
+    Notes
+    - Cursors walk the stored slots in place; nothing is expanded up front.
+      Tree entries come in pre-order, so a container is restored before its contents.
+    - The job only references the vehicle; if it is deleted meanwhile (or
+      spawned without an inventory), IsValid() turns false and the owner
+      completes the job as failed.
+*/
+class BGL_RehydrationJob
+{
+	IEntity m_Vehicle;                            //!< Spawned vehicle being populated
+	InventoryStorageManagerComponent m_Inventory; //!< Vehicle inventory manager
+	ref BGL_VehicleStorageEntity m_VehData;       //!< Stored entry being restored
+	int m_iPlayerId;                              //!< Requesting player (notification/key)
+	string m_sGarageKey;                          //!< Garage the vehicle was withdrawn from
+	int m_iConvoyId;                              //!< Convoy the vehicle belongs to (0 = none, see BGL_WithdrawalConvoy)
+	int m_iQueuedTick;                            //!< Tick the job was created (BGL_Metrics)
+
+	protected ref array<IEntity> m_aDefaultItems = {}; //!< Items to clear (phase 1)
+	protected int m_iDeleteCursor;                     //!< Next default item to delete
+	protected int m_iSlotCursor;                       //!< Current stored slot (phase 2)
+	protected int m_iUnitCursor;                       //!< Units already spawned from current slot
+	protected ref array<IEntity> m_aRestored = {};     //!< Restored entity per stored slot (null for legacy/failed)
+
+	/*!
+	    Constructor
+	    - Snapshots the default items to clear
+	*/
+	void BGL_RehydrationJob(IEntity vehicle, InventoryStorageManagerComponent inventory, BGL_VehicleStorageEntity vehData, string garageKey, int playerId)
+	{
+		m_Vehicle = vehicle;
+		m_Inventory = inventory;
+		m_VehData = vehData;
+		m_sGarageKey = garageKey;
+		m_iPlayerId = playerId;
+		m_iQueuedTick = System.GetTickCount();
+
+		if (m_Inventory)
+			m_Inventory.GetItems(m_aDefaultItems);
+	}
+
+	/*!
+	    False once the vehicle (or its inventory) no longer exists.
+	*/
+	bool IsValid()
+	{
+		return m_Vehicle && m_Inventory;
+	}
+
+	/*!
+	    Advance the job within a budget.
+	    \param maxItems  Maximum units of work (deletes + spawns) this call
+	    \param startTick System.GetTickCount() at the start of the owner's tick
+	    \param budgetMs  Milliseconds allowed since startTick
+	    \return true when every item has been restored
+	*/
+	bool Step(int maxItems, int startTick, float budgetMs)
+	{
+		int done;
+		while (done < maxItems && System.GetTickCount() - startTick < budgetMs)
+		{
+			// Phase 1: clear default items
+			if (m_iDeleteCursor < m_aDefaultItems.Count())
+			{
+				IEntity item = m_aDefaultItems[m_iDeleteCursor];
+				if (item)
+					m_Inventory.TryDeleteItem(item);
+
+				m_iDeleteCursor++;
+				done++;
+				continue;
+			}
+
+			// Phase 2: spawn stored item units
+			if (m_iSlotCursor >= m_VehData.inventory.Count())
+				return true;
+
+			BGL_VehicleInventorySlot slot = m_VehData.inventory[m_iSlotCursor];
+			if (slot.IsPlaced())
+			{
+				m_aRestored.Insert(RestorePlaced(slot));
+				m_iSlotCursor++;
+				done++;
+				continue;
+			}
+
+			if (m_iUnitCursor >= slot.count)
+			{
+				m_aRestored.Insert(null);
+				m_iSlotCursor++;
+				m_iUnitCursor = 0;
+				continue;
+			}
+
+			m_Inventory.TrySpawnPrefabToStorage(slot.prefab);
+			m_iUnitCursor++;
+			done++;
+		}
+
+		return m_iDeleteCursor >= m_aDefaultItems.Count() && m_iSlotCursor >= m_VehData.inventory.Count();
+	}
+
+	/*!
+	    Spawn one tree entry into its recorded storage and slot.
+	    \return The restored item, or null if it could not be placed
+	*/
+	protected IEntity RestorePlaced(BGL_VehicleInventorySlot slot)
+	{
+		IEntity container = m_Vehicle;
+		if (slot.parent >= 0)
+			container = m_aRestored[slot.parent];
+
+		if (!container)
+		{
+			// Container failed to restore: keep the item, let the search place it
+			m_Inventory.TrySpawnPrefabToStorage(slot.prefab);
+			return null;
+		}
+
+		Resource resource = BGL_PrefabCache.GetInstance().Get(slot.prefab);
+		if (!resource || !resource.IsValid())
+			return null;
+
+		IEntity item = GetGame().SpawnEntityPrefab(resource, m_Vehicle.GetWorld());
+		if (!item)
+			return null;
+
+		array<BaseInventoryStorageComponent> storages = {};
+		BGL_InventorySnapshot.GetStorages(container, storages);
+
+		bool inserted;
+		if (slot.storage < storages.Count())
+			inserted = m_Inventory.TryInsertItemInStorage(item, storages[slot.storage], slot.slot);
+
+		if (!inserted)
+			inserted = m_Inventory.TryInsertItem(item);
+
+		if (!inserted)
+		{
+			SCR_EntityHelper.DeleteEntityAndChildren(item);
+			return null;
+		}
+
+		ClearContents(item);
+		return item;
+	}
+
+	/*!
+	    Delete the default contents of a freshly spawned container; the
+	    stored contents follow as its child entries.
+	*/
+	protected void ClearContents(IEntity item)
+	{
+		array<BaseInventoryStorageComponent> storages = {};
+		BGL_InventorySnapshot.GetStorages(item, storages);
+		foreach (BaseInventoryStorageComponent storage : storages)
+		{
+			array<IEntity> contents = {};
+			storage.GetAll(contents);
+			foreach (IEntity content : contents)
+			{
+				m_Inventory.TryDeleteItem(content);
+			}
+		}
+	}
+}
@@ -0,0 +1,226 @@
+//! Body of POST <url>garages/fetch.
+class BGL_RestFetchRequest : JsonApiStruct
+{
+	ref array<string> keys;
+
+	void BGL_RestFetchRequest()
+	{
+		RegV("keys");
+		keys = new array<string>();
+	}
+}
+
+//! Reply of POST <url>garages/fetch.
+class BGL_RestFetchReply : JsonApiStruct
+{
+	ref array<ref BGL_StorageDocument> garages;
+
+	void BGL_RestFetchReply()
+	{
+		RegV("garages");
+		garages = new array<ref BGL_StorageDocument>();
+	}
+}
+
+//! Body of POST <url>garages/commit.
+class BGL_RestCommitRequest : JsonApiStruct
+{
+	ref array<ref BGL_StorageDocument> writes;
+
+	void BGL_RestCommitRequest()
+	{
+		RegV("writes");
+		writes = new array<ref BGL_StorageDocument>();
+	}
+}
+
+//! Reply of POST <url>garages/commit.
+class BGL_RestCommitReply : JsonApiStruct
+{
+	ref array<ref BGL_StorageCommitResult> results;
+
+	void BGL_RestCommitReply()
+	{
+		RegV("results");
+		results = new array<ref BGL_StorageCommitResult>();
+	}
+}
+
+/*!
+    BGL_RestStorageCall
+    -------------------------
+    One in-flight request of BGL_RestStorageBackend; forwards the outcome
+    to the backend with the keys it carried.
+*/
+class BGL_RestStorageCall : RestCallback
+{
+	protected BGL_RestStorageBackend m_Backend;
+	ref array<string> m_aKeys = {}; //!< Garage keys in the request
+	bool m_bCommit;                 //!< Commit (true) or fetch (false)
+	int m_iSentTick;                //!< Tick count when sent (round-trip metric)
+
+	void BGL_RestStorageCall(BGL_RestStorageBackend backend, bool commit)
+	{
+		m_Backend = backend;
+		m_bCommit = commit;
+		m_iSentTick = System.GetTickCount();
+		SetOnSuccess(OnCallSuccess);
+		SetOnError(OnCallError);
+	}
+
+	protected void OnCallSuccess(RestCallback cb)
+	{
+		m_Backend.OnCallReply(this, cb.GetData());
+	}
+
+	protected void OnCallError(RestCallback cb)
+	{
+		m_Backend.OnCallFailed(this, cb.GetHttpCode());
+	}
+}
+
+/*!
+    BGL_RestStorageBackend
+    -------------------------
+    Storage backend on a REST/JSON service shared by several servers, so a
+    player's garage follows them between server instances. The local
+    sharded files stay as the read-through cache (BGL_GarageCache).
+
+    Protocol (both POST, JSON bodies, relative to the base URL)
+    - garages/fetch
+        request:  { "keys": ["<key>", ...] }
+        reply:    { "garages": [ { "key", "version", "garage" }, ... ] }
+                  (keys the service does not hold are left out)
+    - garages/commit
+        request:  { "writes": [ { "key", "version", "garage" }, ... ] }
+                  (version = the version the write is based on, 0 for a new key)
+        reply:    { "results": [ { "key", "ok", "version", "garage" }, ... ] }
+        The service accepts a write only if its stored version equals the
+        write's version, then stores the garage as version + 1 (ok, new
+        version). Otherwise it returns ok = false with its current version
+        and garage, leaving its copy unchanged.
+
+    Notes
+    - A service implementing the two endpoints over a key → (version,
+      garage) map is enough for local testing.
+    - Sends "Authorization: Bearer <token>" when a token is configured.
+    - Transport errors and timeouts are reported by RestContext and passed
+      to BGL_GarageCache.OnBackendFailed (the batch is retried).
+*/
+class BGL_RestStorageBackend : BGL_StorageBackend
+{
+	static const string FETCH_PATH = "garages/fetch";
+	static const string COMMIT_PATH = "garages/commit";
+
+	protected string m_sUrl;                                         //!< Service base URL (with trailing slash)
+	protected string m_sToken;                                       //!< Bearer token (optional)
+	protected RestContext m_Context;                                 //!< Created on first request
+	protected ref array<ref BGL_RestStorageCall> m_aCalls = {};      //!< Requests in flight (keeps callbacks alive)
+
+	void BGL_RestStorageBackend(string url, string token)
+	{
+		m_sUrl = url;
+		if (!m_sUrl.EndsWith("/"))
+			m_sUrl += "/";
+
+		m_sToken = token;
+	}
+
+	override bool IsRemote()
+	{
+		return true;
+	}
+
+	override void Fetch(notnull array<string> keys)
+	{
+		BGL_RestFetchRequest request = new BGL_RestFetchRequest();
+		request.keys.Copy(keys);
+		request.Pack();
+
+		BGL_RestStorageCall call = new BGL_RestStorageCall(this, false);
+		call.m_aKeys.Copy(keys);
+		m_aCalls.Insert(call);
+
+		BGL_Metrics.Observe("backend_fetch_batch", keys.Count());
+		GetContext().POST(call, FETCH_PATH, request.AsString());
+	}
+
+	override void Commit(notnull array<ref BGL_StorageDocument> writes, bool blocking)
+	{
+		BGL_RestCommitRequest request = new BGL_RestCommitRequest();
+		BGL_RestStorageCall call = new BGL_RestStorageCall(this, true);
+		foreach (BGL_StorageDocument write : writes)
+		{
+			request.writes.Insert(write);
+			call.m_aKeys.Insert(write.key);
+		}
+		request.Pack();
+
+		string body = request.AsString();
+		BGL_Metrics.Observe("backend_commit_batch", writes.Count());
+		BGL_Metrics.Observe("backend_commit_bytes", body.Length());
+
+		if (blocking)
+		{
+			string reply = GetContext().POST_now(COMMIT_PATH, body);
+			if (reply.IsEmpty())
+				OnCallFailed(call, 0);
+			else
+				OnCallReply(call, reply);
+
+			return;
+		}
+
+		m_aCalls.Insert(call);
+		GetContext().POST(call, COMMIT_PATH, body);
+	}
+
+	/*!
+	    Reply of a request (called by BGL_RestStorageCall).
+	*/
+	void OnCallReply(BGL_RestStorageCall call, string data)
+	{
+		BGL_Metrics.Lap("backend_rtt_ms", call.m_iSentTick);
+
+		if (call.m_bCommit)
+		{
+			BGL_RestCommitReply commitReply = new BGL_RestCommitReply();
+			commitReply.ExpandFromRAW(data);
+			m_Cache.OnCommitReply(call.m_aKeys, commitReply.results);
+		}
+		else
+		{
+			BGL_RestFetchReply fetchReply = new BGL_RestFetchReply();
+			fetchReply.ExpandFromRAW(data);
+			m_Cache.OnFetchReply(call.m_aKeys, fetchReply.garages);
+		}
+
+		m_aCalls.RemoveItem(call);
+	}
+
+	/*!
+	    Failed request (called by BGL_RestStorageCall).
+	*/
+	void OnCallFailed(BGL_RestStorageCall call, int httpCode)
+	{
+		Print(string.Format("BGL: storage backend %1 failed (HTTP %2, %3 garages)", m_sUrl, httpCode, call.m_aKeys.Count()), LogLevel.WARNING);
+		BGL_Metrics.Count("backend_failed_total");
+		m_Cache.OnBackendFailed(call.m_aKeys, call.m_bCommit);
+		m_aCalls.RemoveItem(call);
+	}
+
+	protected RestContext GetContext()
+	{
+		if (m_Context)
+			return m_Context;
+
+		m_Context = GetGame().GetRestApi().GetContext(m_sUrl);
+
+		string headers = "Content-Type,application/json";
+		if (!m_sToken.IsEmpty())
+			headers += ",Authorization,Bearer " + m_sToken;
+
+		m_Context.SetHeaders(headers);
+		return m_Context;
+	}
+}
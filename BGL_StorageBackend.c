@@ -0,0 +1,156 @@
+//! Where garages are stored (BGL_Component.m_eStorageBackend).
+enum EBGL_StorageBackend
+{
+	FILE, //!< Local sharded files under $profile:BLG only (BGL_FileStorageBackend)
+	REST  //!< Shared REST/JSON service, local files as read-through cache (BGL_RestStorageBackend)
+}
+
+/*!
+    BGL_StorageDocument
+    -------------------------
+    One garage as exchanged with a storage backend.
+
+    Fields
+    - key:     Garage key (player UID or pool key)
+    - version: Backend version of the garage. In a commit it is the version
+               the write is based on; in a fetch reply the current one.
+    - garage:  Garage payload (BGL_PlayerGarageStorageEntity JSON)
+*/
+class BGL_StorageDocument : JsonApiStruct
+{
+	string key;
+	int version;
+	ref BGL_PlayerGarageStorageEntity garage;
+
+	void BGL_StorageDocument()
+	{
+		RegV("key");
+		RegV("version");
+		RegV("garage");
+		garage = new BGL_PlayerGarageStorageEntity();
+	}
+}
+
+/*!
+    BGL_StorageCommitResult
+    -------------------------
+    Outcome of one write in a commit batch.
+
+    Fields
+    - key:     Garage key
+    - ok:      True if the write was accepted
+    - version: New version (ok), or the backend's current version (conflict;
+               0 if the backend holds no copy)
+    - garage:  Backend's current copy on a conflict (empty if it holds none)
+*/
+class BGL_StorageCommitResult : JsonApiStruct
+{
+	string key;
+	bool ok;
+	int version;
+	ref BGL_PlayerGarageStorageEntity garage;
+
+	void BGL_StorageCommitResult()
+	{
+		RegV("key");
+		RegV("ok");
+		RegV("version");
+		RegV("garage");
+		garage = new BGL_PlayerGarageStorageEntity();
+	}
+}
+
+/*!
+    BGL_StorageBackend
+    -------------------------
+    Durable store behind BGL_GarageCache (and so behind
+    BGL_Component.LoadPlayerGarageData / SavePlayerGarageData).
+
+    Contract
+    - Fetch(keys): read a batch of garages; the reply goes to
+      BGL_GarageCache.OnFetchReply with the documents that exist.
+    - Commit(writes): write a batch of garages, each accepted only if its
+      version still matches the backend's (optimistic versioning); the
+      reply goes to BGL_GarageCache.OnCommitReply with a result per write
+      (writes without a result are retried).
+    - A failed request goes to BGL_GarageCache.OnBackendFailed.
+    - One fetch and one commit batch are in flight at a time (the cache
+      batches keys between ticks).
+
+    Notes
+    - Remote backends (IsRemote) may answer asynchronously. The cache keeps
+      serving its in-memory copy and the local files, so no round trip sits
+      on an interaction; a garage only blocks mutations while the fetch
+      started by loading it is in flight (BGL_GarageCache.IsSyncing).
+    - Commit(writes, true) must complete before returning (shutdown flush).
+*/
+class BGL_StorageBackend
+{
+	protected BGL_GarageCache m_Cache; //!< Receives replies (owns this backend)
+
+	/*!
+	    Bind the cache that receives replies (called by BGL_GarageCache.SetBackend).
+	*/
+	void Attach(BGL_GarageCache cache)
+	{
+		m_Cache = cache;
+	}
+
+	/*!
+	    True if the backend holds a copy other than the local files, so the
+	    cache has to fetch and commit garages.
+	*/
+	bool IsRemote()
+	{
+		return false;
+	}
+
+	/*!
+	    Read a batch of garages (reply: BGL_GarageCache.OnFetchReply).
+	*/
+	void Fetch(notnull array<string> keys)
+	{
+	}
+
+	/*!
+	    Write a batch of garages (reply: BGL_GarageCache.OnCommitReply).
+	    \param blocking Complete before returning
+	*/
+	void Commit(notnull array<ref BGL_StorageDocument> writes, bool blocking)
+	{
+	}
+}
+
+/*!
+    BGL_FileStorageBackend
+    -------------------------
+    Default backend: the sharded files under $profile:BLG written by
+    BGL_GarageCache / BGL_GarageWriter are the store. There is no other
+    copy to read or commit to, so the cache's sync path stays idle.
+*/
+class BGL_FileStorageBackend : BGL_StorageBackend
+{
+	override void Fetch(notnull array<string> keys)
+	{
+		array<ref BGL_StorageDocument> found = {};
+		m_Cache.OnFetchReply(keys, found);
+	}
+
+	override void Commit(notnull array<ref BGL_StorageDocument> writes, bool blocking)
+	{
+		array<string> keys = {};
+		array<ref BGL_StorageCommitResult> results = {};
+		foreach (BGL_StorageDocument write : writes)
+		{
+			keys.Insert(write.key);
+
+			BGL_StorageCommitResult result = new BGL_StorageCommitResult();
+			result.key = write.key;
+			result.ok = true;
+			result.version = write.version + 1;
+			results.Insert(result);
+		}
+
+		m_Cache.OnCommitReply(keys, results);
+	}
+}
@@ -8,15 +8,25 @@
     - Executes only on the server side.
     - Resolves the player performing the action via PlayerManager and BackendApi.
     - Retrieves the owning BGL_Component from the interacted entity.
-    - Delegates to BGL_Component.Store() with the player’s UID and ID.
+    - Delegates to BGL_Component.Store() with the player’s UID and ID, into
+      the garage selected by m_eScope (personal, or a faction/group pool),
+      or to BGL_Component.StoreAll() when m_bStoreAll is set.
 
     Notes
     - This action is tied to a prefab/entity with a BGL_Component.
     - Intended to be invoked through ScriptedUserAction framework (usable interaction).
     - Cannot be broadcast to other clients (CanBroadcastScript = false).
+    - Add a second instance with a pool scope to offer "store in motor pool",
+      or with m_bStoreAll to offer "store all my vehicles".
 */
 class BGL_StoreAction : ScriptedUserAction
 {
+	[Attribute(defvalue: "0", uiwidget: UIWidgets.ComboBox, desc: "Garage this action stores into", enums: ParamEnumArray.FromEnum(EBGL_GarageScope))]
+	EBGL_GarageScope m_eScope; //!< Personal garage or faction/group pool
+
+	[Attribute(defvalue: "0", desc: "Store every keyed vehicle of the player in range instead of the nearest one")]
+	bool m_bStoreAll; //!< Use BGL_Component.StoreAll()
+
 	/*!
 	    Called when the player performs this action.
 
@@ -25,7 +35,7 @@ class BGL_StoreAction : ScriptedUserAction
 	    - Resolve playerId from the controlled entity.
 	    - Query BackendApi to get a persistent UID for this player.
 	    - Find the BGL_Component on the owner entity.
-	    - Call BGL_Component.Store(playerUid, playerId).
+	    - Call BGL_Component.Store(playerUid, playerId, m_eScope), or StoreAll() with m_bStoreAll.
 
 	    \param pOwnerEntity The entity that owns this user action (expected to contain BGL_Component).
 	    \param pUserEntity  The entity that initiated the action (the player’s controlled entity).
@@ -53,8 +63,11 @@ class BGL_StoreAction : ScriptedUserAction
 		if (!bgl)
 			return;
 
-		// Store the vehicle/item for this player
-		bgl.Store(playerUid, playerId);
+		// Store the vehicle/item (or every vehicle in range) for this player
+		if (m_bStoreAll)
+			bgl.StoreAll(playerUid, playerId, m_eScope);
+		else
+			bgl.Store(playerUid, playerId, m_eScope);
 	}
 
 	/*!
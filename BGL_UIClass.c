@@ -2,44 +2,72 @@
     BGL_UIClass
     -------------------------
     A player-facing garage menu for browsing, previewing, spawning, and deleting
-    stored vehicles. The menu is backed by a serialized player storage string
-    (m_playerStorageString) which is expanded into a BGL_PlayerGarageStorageEntity.
+    stored vehicles. The menu is backed by the player controller's cached
+    BGL_GarageSummary per garage (compact per-vehicle rows at a known storage
+    revision): the player's own garage first, then any faction/group pools
+    the sign offers.
 
     Responsibilities
     - Wire up UI widgets and button/input handlers
     - Populate a list of stored vehicles with friendly names
     - Preview the currently selected vehicle prefab
+    - Fetch and show the selected vehicle's inventory/key details on demand,
+      caching them for the rest of the menu session
+
+    Session model
+    - Rows, labels and garage of each row are derived once per menu session
+      (Main) and details text once per fetched vehicle (keyed by garage key +
+      vehicle id); selection changes only read these caches.
+    - Deletes are applied to the session model and list rows in place instead
+      of rebuilding the list; nothing is re-serialized except the op sent to
+      the server.
     - Request spawn/delete actions via SCR_PlayerController RPCs
-    - Keep the local storage string in sync after deletions
+    - Keep the cached summary in sync after deletions (via the controller)
 
     Assumptions
     - The root layout contains widgets with ids:
       "ListBoxVehicle", "VehicleNameText", "VehicleDetailsText",
-      "ItemPreview0", "SpawnButton", "DeleteButton", "CloseButton".
-    - m_playerStorageString is set before the menu opens (via SetPlayerStorage).
+      "ItemPreview0", "SpawnButton", "DeleteButton", "ConvoyButton", "CloseButton".
+    - m_garages is set before the menu opens (via SetGarages).
     - ItemPreviewManager is available from ChimeraWorld.
 
     Notes
-    - Vehicle delete is local-side mutation + client save request.
-    - Spawning is requested through the player controller with current selection index.
+    - List rows are the garages' vehicles in garage order; pool rows are
+      prefixed with the pool label. Every request (spawn, delete, details)
+      sends the row's garage key and stable vehicle id.
+    - Vehicle delete is a (garage key, vehicle id, revision) operation sent by
+      the controller, which also applies it to that garage's shared summary.
+    - "ConvoyButton" marks/unmarks the selected row for a convoy; spawning
+      with rows marked withdraws them (plus the selected row) as one convoy.
 */
 class BGL_UIClass : MenuBase
 {
+	private static const int DETAILS_TIMEOUT_MS = 5000; //!< Details request considered lost after this
+
 	// --- UI widgets ---
 	private SCR_ListBoxComponent m_vehList;               //!< Vehicle list UI
 	private SCR_InputButtonComponent m_spawnBtn;          //!< Spawn button
 	private SCR_InputButtonComponent m_deleteBtn;         //!< Delete button
+	private SCR_InputButtonComponent m_convoyBtn;         //!< Mark/unmark for convoy button
 	private SCR_InputButtonComponent m_closeBtn;          //!< Close button
 	private TextWidget m_vehName;                         //!< Selected vehicle name text
-	private TextWidget m_vehDetails;                      //!< (Reserved) details text
+	private TextWidget m_vehDetails;                      //!< Inventory/key details text
 	private ItemPreviewWidget m_vehPreview;               //!< 3D preview widget
 	private ItemPreviewManagerEntity m_ItemPreviewManager;//!< Preview manager
 
 	// --- Context/state ---
 	private BGL_Component m_bgl;          //!< Reference to owning/related component (for future use)
 	private string m_playerUid;           //!< Active player's UID (used for spawn request)
-	private string m_playerStorageString; //!< Packed storage payload for vehicles
+	private ref array<BGL_GarageSummary> m_garages = {};  //!< Listed garage summaries (owned by the controller)
 	private int m_vehSelected;            //!< Current index in the list (-1 when none)
+	private ref array<string> m_vehLabels = {};                      //!< Friendly names by list index (this session)
+	private ref array<BGL_VehicleSummary> m_vehRows = {};            //!< Vehicle by list index (this session)
+	private ref array<string> m_vehRowGarages = {};                  //!< Garage key by list index (this session)
+	private ref map<string, string> m_vehDetailsText = new map<string, string>(); //!< Formatted details by "garageKey#id" (this session)
+	private ref set<string> m_vehDetailsPending = new set<string>(); //!< "garageKey#id" with a details request in flight
+	private ResourceName m_previewPrefab;                            //!< Prefab currently shown in the preview
+	private ref array<string> m_convoyGarages = {};                  //!< Garage key of each row marked for the convoy
+	private ref array<int> m_convoyIds = {};                         //!< Vehicle id of each row marked for the convoy (parallel)
 
 	// =========================================================
 	// Public API
@@ -47,10 +75,11 @@ class BGL_UIClass : MenuBase
 
 	/*!
 	    Entry point you can call after creating the menu if you want an explicit kick-off.
-	    Currently just repopulates the list from storage.
+	    Builds the session model (labels) once, then populates the list from it.
 	*/
 	void Main()
 	{
+		BuildSessionModel();
 		Populate();
 	}
 
@@ -73,6 +102,7 @@ class BGL_UIClass : MenuBase
 		m_vehPreview = ItemPreviewWidget.Cast(root.FindAnyWidget("ItemPreview0"));
 		m_spawnBtn = SCR_InputButtonComponent.GetInputButtonComponent("SpawnButton", root);
 		m_deleteBtn = SCR_InputButtonComponent.GetInputButtonComponent("DeleteButton", root);
+		m_convoyBtn = SCR_InputButtonComponent.GetInputButtonComponent("ConvoyButton", root);
 		m_closeBtn = SCR_InputButtonComponent.GetInputButtonComponent("CloseButton", root);
 
 		SetupButtonHandlers();
@@ -86,28 +116,56 @@ class BGL_UIClass : MenuBase
 	{
 		m_spawnBtn.m_OnActivated.Insert(OnBtnSpawnPressed);
 		m_deleteBtn.m_OnActivated.Insert(OnBtnDeletePressed);
+		m_convoyBtn.m_OnActivated.Insert(OnBtnConvoyPressed);
 		m_closeBtn.m_OnActivated.Insert(Close);
 		m_vehList.m_OnChanged.Insert(OnSelectItemChanged);
 	}
 
 	/*!
-	    Populate the vehicle list from the player's storage.
+	    Derive per-session view data from the garage summaries (once per open).
+	*/
+	private void BuildSessionModel()
+	{
+		m_vehLabels.Clear();
+		m_vehRows.Clear();
+		m_vehRowGarages.Clear();
+		m_vehDetailsText.Clear();
+		m_vehDetailsPending.Clear();
+		m_convoyGarages.Clear();
+		m_convoyIds.Clear();
+		m_vehSelected = -1;
+
+		foreach (BGL_GarageSummary garage : m_garages)
+		{
+			string prefix;
+			if (BGL_GaragePools.IsPool(garage.garageKey))
+				prefix = string.Format("[%1] ", BGL_GaragePools.GetLabel(garage.garageKey));
+
+			foreach (BGL_VehicleSummary veh : garage.vehicles)
+			{
+				m_vehLabels.Insert(prefix + GetFriendlyVehicleName(veh.prefab));
+				m_vehRows.Insert(veh);
+				m_vehRowGarages.Insert(garage.garageKey);
+			}
+		}
+	}
+
+	/*!
+	    Populate the vehicle list from the session labels.
 	    - If no vehicles are stored, adds a single "No stored vehicles" row.
 	*/
 	private void Populate()
 	{
 		m_vehList.Clear();
 
-		array<ref BGL_VehicleStorageEntity> vehs = GetVehicles();
-		if (!vehs || vehs.IsEmpty())
+		if (m_vehLabels.IsEmpty())
 		{
 			m_vehList.AddItem("No stored vehicles");
 			return;
 		}
 
-		foreach (BGL_VehicleStorageEntity veh : vehs)
+		foreach (string label : m_vehLabels)
 		{
-			string label = GetFriendlyVehicleName(veh.prefab);
 			m_vehList.AddItem(label);
 		}
 	}
@@ -133,80 +191,176 @@ class BGL_UIClass : MenuBase
 	/*!
 	    Update the 3D preview widget with the selected vehicle.
 
-	    \param veh Vehicle storage entry holding the prefab path to preview.
+	    \param veh Vehicle summary holding the prefab path to preview.
 	    \pre m_ItemPreviewManager and m_vehPreview are valid.
 	*/
-	private void UpdateVehPreview(BGL_VehicleStorageEntity veh)
+	private void UpdateVehPreview(BGL_VehicleSummary veh)
 	{
+		if (veh.prefab == m_previewPrefab)
+			return;
+
+		m_previewPrefab = veh.prefab;
 		m_ItemPreviewManager.SetPreviewItemFromPrefab(m_vehPreview, veh.prefab);
 	}
 
 	/*!
-	    Update the UI vehicle name text from the selected vehicle.
+	    Update the UI vehicle name text from the session labels.
 
-	    \param veh Vehicle storage entry.
+	    \param index Selected list index.
 	*/
-	private void UpdateVehName(BGL_VehicleStorageEntity veh)
+	private void UpdateVehName(int index)
 	{
-		m_vehName.SetText(GetFriendlyVehicleName(veh.prefab));
+		if (FindConvoyIndex(m_vehRowGarages[index], m_vehRows[index].id) >= 0)
+			m_vehName.SetText(m_vehLabels[index] + " (convoy)");
+		else
+			m_vehName.SetText(m_vehLabels[index]);
 	}
 
 	/*!
-	    Delete the currently selected vehicle from the player's storage.
+	    Position of a vehicle among the rows marked for the convoy, or -1.
+	*/
+	private int FindConvoyIndex(string garageKey, int vehicleId)
+	{
+		foreach (int i, int convoyId : m_convoyIds)
+		{
+			if (convoyId == vehicleId && m_convoyGarages[i] == garageKey)
+				return i;
+		}
+		return -1;
+	}
 
-	    Flow:
-	    - Validate selection and storage
-	    - Remove entry from storage array
-	    - Ask the player controller to persist (BGL_Client_RequestSavePlayerStorage)
-	    - Re-pack the local storage string for future reads
+	/*!
+	    Show the number of marked rows on the convoy button.
+	*/
+	private void UpdateConvoyLabel()
+	{
+		if (m_convoyIds.IsEmpty())
+			m_convoyBtn.SetLabel("Add To Convoy");
+		else
+			m_convoyBtn.SetLabel(string.Format("Convoy (%1)", m_convoyIds.Count()));
+	}
 
-	    Side effects:
-	    - Mutates both in-memory storage and m_playerStorageString
-	    - Calls into player controller to save
+	/*!
+	    Update the details text from the session cache, requesting the entry
+	    from the server on a miss (reply arrives via SetVehicleDetails).
+	    At most one request per vehicle is in flight; one without a reply
+	    after DETAILS_TIMEOUT_MS is dropped (OnVehDetailsTimeout) so the next
+	    selection asks again.
 
-	    No-op if there is no valid selection or storage is empty.
+	    \param index Selected list index (header shown while details load).
 	*/
-	private void DeleteCar()
+	private void UpdateVehDetails(int index)
 	{
-		BGL_PlayerGarageStorageEntity storage = GetPlayerStorage();
-		if (!storage || storage.vehicles.IsEmpty())
+		if (!m_vehDetails)
 			return;
 
-		if (m_vehSelected < 0 || m_vehSelected >= storage.vehicles.Count())
+		BGL_VehicleSummary veh = m_vehRows[index];
+		string garageKey = m_vehRowGarages[index];
+		string detailsKey = GetDetailsKey(garageKey, veh.id);
+
+		string text;
+		if (m_vehDetailsText.Find(detailsKey, text))
+		{
+			m_vehDetails.SetText(text);
 			return;
+		}
+
+		m_vehDetails.SetText(string.Format("Items: %1", veh.item_count));
 
-		storage.vehicles.Remove(m_vehSelected);
+		if (m_vehDetailsPending.Contains(detailsKey))
+			return;
 
+		m_vehDetailsPending.Insert(detailsKey);
 		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerController());
-		playerController.BGL_Client_RequestSavePlayerStorage(storage);
+		playerController.BGL_Client_RequestVehicleDetails(garageKey, veh.id);
+		GetGame().GetCallqueue().CallLater(OnVehDetailsTimeout, DETAILS_TIMEOUT_MS, false, detailsKey);
+	}
+
+	/*!
+	    Drop a details request whose reply never arrived; if that vehicle is
+	    still selected, say so instead of leaving the header up.
+	*/
+	private void OnVehDetailsTimeout(string detailsKey)
+	{
+		if (!m_vehDetailsPending.Contains(detailsKey))
+			return; // answered or deleted
 
-		storage.Pack();
-		m_playerStorageString = storage.AsString();
-		return;
+		m_vehDetailsPending.RemoveItem(detailsKey);
+
+		if (!m_vehDetails || m_vehSelected < 0 || m_vehSelected >= m_vehRows.Count())
+			return;
+
+		BGL_VehicleSummary veh = m_vehRows[m_vehSelected];
+		if (GetDetailsKey(m_vehRowGarages[m_vehSelected], veh.id) == detailsKey)
+			m_vehDetails.SetText(string.Format("Items: %1\nDetails unavailable, select the vehicle again to retry.", veh.item_count));
 	}
 
 	/*!
-	    Deserialize the local storage string into a structured storage entity.
+	    Session cache key for a vehicle's details (ids are per garage).
+	*/
+	private string GetDetailsKey(string garageKey, int vehicleId)
+	{
+		return string.Format("%1#%2", garageKey, vehicleId);
+	}
 
-	    \return BGL_PlayerGarageStorageEntity expanded from m_playerStorageString.
-	    \note Returns a new instance each call; callers should cache if needed.
+	/*!
+	    Build the details text for a fetched vehicle entry.
+	    One line per item prefab ("Name xCount", nested items included),
+	    preceded by the key id.
 	*/
-	private BGL_PlayerGarageStorageEntity GetPlayerStorage()
+	private string FormatVehDetails(BGL_VehicleStorageEntity details)
 	{
-		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
-		storage.ExpandFromRAW(m_playerStorageString);
-		return storage;
+		string text = string.Format("Key: %1", details.key_id);
+		map<string, int> counts = details.ToMap();
+		foreach (string prefab, int count : counts)
+		{
+			text += string.Format("\n%1 x%2", GetFriendlyVehicleName(prefab), count);
+		}
+		return text;
 	}
 
 	/*!
-	    Convenience accessor for the current list of stored vehicles.
+	    Delete the currently selected vehicle from its garage.
+
+	    Flow:
+	    - Validate selection and summary
+	    - Ask the player controller to delete (BGL_Client_RequestDeleteVehicle),
+	      which removes the row from the shared summary and sends the op
+	    - Apply the same removal to the session model and list rows in place
 
-	    \return Array of vehicle entries (may be null if storage failed to expand).
+	    No-op if there is no valid selection or the list is empty.
 	*/
-	private array<ref BGL_VehicleStorageEntity> GetVehicles()
+	private void DeleteCar()
 	{
-		BGL_PlayerGarageStorageEntity storage = GetPlayerStorage();
-		return storage.vehicles;
+		int index = m_vehSelected;
+		if (index < 0 || index >= m_vehRows.Count())
+			return;
+
+		int vehicleId = m_vehRows[index].id;
+		string garageKey = m_vehRowGarages[index];
+		string detailsKey = GetDetailsKey(garageKey, vehicleId);
+
+		m_vehLabels.RemoveOrdered(index);
+		m_vehRows.RemoveOrdered(index);
+		m_vehRowGarages.RemoveOrdered(index);
+		m_vehDetailsText.Remove(detailsKey);
+		m_vehDetailsPending.RemoveItem(detailsKey);
+		m_vehSelected = -1;
+
+		int convoyIndex = FindConvoyIndex(garageKey, vehicleId);
+		if (convoyIndex >= 0)
+		{
+			m_convoyGarages.RemoveOrdered(convoyIndex);
+			m_convoyIds.RemoveOrdered(convoyIndex);
+			UpdateConvoyLabel();
+		}
+
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerController());
+		playerController.BGL_Client_RequestDeleteVehicle(garageKey, vehicleId);
+
+		m_vehList.RemoveItem(index);
+		if (m_vehLabels.IsEmpty())
+			m_vehList.AddItem("No stored vehicles");
 	}
 
 	// =========================================================
@@ -229,6 +383,7 @@ class BGL_UIClass : MenuBase
 		// Action shortcuts
 		GetGame().GetInputManager().AddActionListener("MenuSelectHold", EActionTrigger.DOWN, OnBtnSpawnPressed);
 		GetGame().GetInputManager().AddActionListener("MenuCalibrateMotionControl", EActionTrigger.DOWN, OnBtnDeletePressed);
+		GetGame().GetInputManager().AddActionListener("MenuRefresh", EActionTrigger.DOWN, OnBtnConvoyPressed);
 
 		ChimeraWorld world = ChimeraWorld.CastFrom(GetGame().GetWorld());
 		if (world)
@@ -252,6 +407,7 @@ class BGL_UIClass : MenuBase
 	/*!
 	    Called when the menu is closed.
 	    - Unbinds global input actions to avoid leaks/duplication.
+	    - Cancels pending details timeouts.
 	*/
 	override void OnMenuClose()
 	{
@@ -261,6 +417,9 @@ class BGL_UIClass : MenuBase
 		GetGame().GetInputManager().RemoveActionListener("MenuEscape", EActionTrigger.DOWN, Close);
 		GetGame().GetInputManager().RemoveActionListener("MenuSelectHold", EActionTrigger.DOWN, OnBtnSpawnPressed);
 		GetGame().GetInputManager().RemoveActionListener("MenuCalibrateMotionControl", EActionTrigger.DOWN, OnBtnDeletePressed);
+		GetGame().GetInputManager().RemoveActionListener("MenuRefresh", EActionTrigger.DOWN, OnBtnConvoyPressed);
+
+		GetGame().GetCallqueue().Remove(OnVehDetailsTimeout);
 	}
 
 	// =========================================================
@@ -269,35 +428,72 @@ class BGL_UIClass : MenuBase
 
 	/*!
 	    Spawn button callback.
-	    - Issues a client request to load the selected car (index = m_vehSelected)
+	    - Issues a client request to load the selected car (by garage key + vehicle id),
+	      or a convoy request for the marked rows plus the selected one
 	    - Closes the menu afterwards
 
 	    Preconditions:
-	    - m_playerUid must be set
 	    - m_vehSelected should reference a valid vehicle (validated server-side)
 	*/
 	private void OnBtnSpawnPressed()
 	{
 		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerController());
-		playerController.BGL_Client_RequestLoadCar(m_playerUid, m_vehSelected);
+
+		// The selected row rides along with the marked ones
+		if (m_vehSelected >= 0 && m_vehSelected < m_vehRows.Count() && FindConvoyIndex(m_vehRowGarages[m_vehSelected], m_vehRows[m_vehSelected].id) < 0)
+		{
+			m_convoyGarages.Insert(m_vehRowGarages[m_vehSelected]);
+			m_convoyIds.Insert(m_vehRows[m_vehSelected].id);
+		}
+
+		if (m_convoyIds.Count() > 1)
+			playerController.BGL_Client_RequestConvoy(m_convoyGarages, m_convoyIds);
+		else if (m_convoyIds.Count() == 1)
+			playerController.BGL_Client_RequestLoadCar(m_convoyGarages[0], m_convoyIds[0]);
+
 		Close();
 	}
 
+	/*!
+	    Convoy button callback.
+	    - Marks the selected row for the convoy, or unmarks it if already marked
+	*/
+	private void OnBtnConvoyPressed()
+	{
+		if (m_vehSelected < 0 || m_vehSelected >= m_vehRows.Count())
+			return;
+
+		string garageKey = m_vehRowGarages[m_vehSelected];
+		int vehicleId = m_vehRows[m_vehSelected].id;
+		int convoyIndex = FindConvoyIndex(garageKey, vehicleId);
+		if (convoyIndex >= 0)
+		{
+			m_convoyGarages.RemoveOrdered(convoyIndex);
+			m_convoyIds.RemoveOrdered(convoyIndex);
+		}
+		else
+		{
+			m_convoyGarages.Insert(garageKey);
+			m_convoyIds.Insert(vehicleId);
+		}
+
+		UpdateConvoyLabel();
+		UpdateVehName(m_vehSelected);
+	}
+
 	/*!
 	    Delete button callback.
-	    - Deletes the current selection from storage
-	    - Repopulates the list to reflect changes
+	    - Deletes the current selection (list rows are updated in place)
 	*/
 	private void OnBtnDeletePressed()
 	{
 		DeleteCar();
-		Populate();
 	}
 
 	/*!
 	    List selection changed callback.
 	    - Updates m_vehSelected
-	    - Updates preview widget and name label to match the new selection
+	    - Updates preview widget, name label and details to match the new selection
 	    - No-ops for invalid indices or empty vehicle lists
 	*/
 	private void OnSelectItemChanged()
@@ -306,13 +502,12 @@ class BGL_UIClass : MenuBase
 		if (m_vehSelected < 0)
 			return;
 
-		array<ref BGL_VehicleStorageEntity> vehs = GetVehicles();
-		if (!vehs || m_vehSelected >= vehs.Count())
-		 return;
+		if (m_vehSelected >= m_vehRows.Count())
+			return;
 
-		BGL_VehicleStorageEntity currentVeh = vehs[m_vehSelected];
-		UpdateVehPreview(currentVeh);
-		UpdateVehName(currentVeh);
+		UpdateVehPreview(m_vehRows[m_vehSelected]);
+		UpdateVehName(m_vehSelected);
+		UpdateVehDetails(m_vehSelected);
 	}
 
 	// =========================================================
@@ -328,7 +523,7 @@ class BGL_UIClass : MenuBase
 	}
 
 	/*!
-	    Set the player UID used when requesting spawns.
+	    Set the player UID (the personal garage key).
 	    \param playerUid The authenticated player's UID.
 	*/
 	void SetPlayerUid(string playerUid)
@@ -337,12 +532,34 @@ class BGL_UIClass : MenuBase
 	}
 
 	/*!
-	    Provide the packed storage string for this player.
-	    Must be called before Populate()/preview usage so storage can expand.
-	    \param storageString Serialized storage payload.
+	    Receive fetched details for a vehicle (called by the player controller).
+	    Formatted once and cached for the session; shown immediately if still selected.
+	*/
+	void SetVehicleDetails(string garageKey, int vehicleId, BGL_VehicleStorageEntity details)
+	{
+		string detailsKey = GetDetailsKey(garageKey, vehicleId);
+		if (!m_vehDetailsPending.Contains(detailsKey))
+			return; // superseded by a delete
+
+		m_vehDetailsPending.RemoveItem(detailsKey);
+
+		string text = FormatVehDetails(details);
+		m_vehDetailsText.Set(detailsKey, text);
+
+		if (!m_vehDetails || m_vehSelected < 0 || m_vehSelected >= m_vehRows.Count())
+			return;
+
+		if (m_vehRowGarages[m_vehSelected] == garageKey && m_vehRows[m_vehSelected].id == vehicleId)
+			m_vehDetails.SetText(text);
+	}
+
+	/*!
+	    Provide the cached garage summaries listed at this sign (personal first).
+	    Must be called before Populate()/preview usage.
+	    \param garages Summaries owned by the local player controller.
 	*/
-	void SetPlayerStorage(string storageString)
+	void SetGarages(notnull array<BGL_GarageSummary> garages)
 	{
-		m_playerStorageString = storageString;
+		m_garages.Copy(garages);
 	}
 }
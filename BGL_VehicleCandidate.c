@@ -0,0 +1,65 @@
+/*!
+    EBGL_CandidateAnchor
+    -------------------------
+    Position that keyed vehicles are ranked against when storing.
+*/
+enum EBGL_CandidateAnchor
+{
+	SIGN,        //!< Garage owner entity (sign / terminal)
+	SPAWN_POINT  //!< BGL_Component spawn transform (m_SpawnPosition)
+}
+
+/*!
+    BGL_VehicleCandidate
+    -------------------------
+    One keyed vehicle gathered by BGL_Component.CollectCandidates().
+
+    Ranking (SortByRank)
+    - Nearest to the anchor first.
+    - Distances within tieDistance of each other count as a tie; ties are
+      broken by the most recent withdrawal by the acting player (when enabled),
+      then by distance.
+*/
+class BGL_VehicleCandidate
+{
+	IEntity m_Vehicle;    //!< Live vehicle entity
+	string m_sKeyId;      //!< Matching key id (player holds it)
+	float m_fDistanceSq;  //!< Squared distance to the anchor
+	int m_iLastUseTick;   //!< Tick of the player's last withdrawal of this vehicle (0 = never)
+
+	/*!
+	    True if a should be stored before b.
+	    \param tieDistance   Meters within which distances are considered equal
+	    \param preferRecent  Break ties by most recent withdrawal by the player
+	*/
+	static bool RanksBefore(BGL_VehicleCandidate a, BGL_VehicleCandidate b, float tieDistance, bool preferRecent)
+	{
+		if (preferRecent && a.m_iLastUseTick != b.m_iLastUseTick)
+		{
+			float distA = Math.Sqrt(a.m_fDistanceSq);
+			float distB = Math.Sqrt(b.m_fDistanceSq);
+			if (Math.AbsFloat(distA - distB) <= tieDistance)
+				return a.m_iLastUseTick > b.m_iLastUseTick;
+		}
+
+		return a.m_fDistanceSq < b.m_fDistanceSq;
+	}
+
+	/*!
+	    Sort candidates in place, best first (insertion sort; lists are small).
+	*/
+	static void SortByRank(notnull array<ref BGL_VehicleCandidate> candidates, float tieDistance, bool preferRecent)
+	{
+		for (int i = 1; i < candidates.Count(); i++)
+		{
+			BGL_VehicleCandidate current = candidates[i];
+			int j = i - 1;
+			while (j >= 0 && RanksBefore(current, candidates[j], tieDistance, preferRecent))
+			{
+				candidates[j + 1] = candidates[j];
+				j--;
+			}
+			candidates[j + 1] = current;
+		}
+	}
+}
@@ -0,0 +1,177 @@
+/*!
+    BGL_VehicleKeyRegistry
+    -------------------------
+    Server-wide map of vehicle key id → live vehicle entities (several
+    vehicles may share one key id).
+
+    Responsibilities
+    - Let BGL_Component.Store() resolve the vehicles matching a player's keys
+      directly, then check distance, instead of sphere-scanning every dynamic
+      entity around the garage.
+    - Stay current through the modded Key_LockComponent below:
+        • vehicle spawn (OnPostInit, with a prefab-assigned id)
+        • id changes (SetID — including LoadCar() and the key mod itself)
+        • vehicle despawn (OnDelete)
+
+    - Remember which player last withdrew each keyed vehicle, and when, for
+      the "most recently used" tie-break of BGL_VehicleCandidate ranking.
+
+    Notes
+    - Only BaseVehicle owners are tracked; CarKey items share the lock
+      component but are never registered.
+    - Entity references are weak; FindAll() also drops entries whose vehicle
+      has been deleted without an OnDelete.
+    - Ids assigned without SetID (direct myID writes, replication) are not
+      seen here; BGL_Component.CollectCandidates() falls back to a sphere
+      query for held keys that miss the registry and registers what it finds.
+*/
+class BGL_VehicleKeyRegistry
+{
+	protected static ref BGL_VehicleKeyRegistry s_Instance;
+
+	protected ref map<string, ref array<IEntity>> m_Vehicles = new map<string, ref array<IEntity>>(); //!< Key id → vehicles
+	protected ref map<string, int> m_LastUsePlayer = new map<string, int>();    //!< Key id → player id of last withdrawal
+	protected ref map<string, int> m_LastUseTick = new map<string, int>();      //!< Key id → tick of last withdrawal
+
+	/*!
+	    Return the server-wide registry, creating it on first use.
+	*/
+	static BGL_VehicleKeyRegistry GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_VehicleKeyRegistry();
+
+		return s_Instance;
+	}
+
+	/*!
+	    Add a vehicle under a key id (other vehicles with the same id stay).
+	*/
+	void Register(string keyId, IEntity vehicle)
+	{
+		if (!keyId || keyId == "" || !vehicle)
+			return;
+
+		array<IEntity> vehicles = m_Vehicles.Get(keyId);
+		if (!vehicles)
+		{
+			vehicles = {};
+			m_Vehicles.Insert(keyId, vehicles);
+		}
+
+		if (!vehicles.Contains(vehicle))
+			vehicles.Insert(vehicle);
+	}
+
+	/*!
+	    Remove a vehicle (and any deleted ones) from a key id.
+	*/
+	void Unregister(string keyId, IEntity vehicle)
+	{
+		array<IEntity> vehicles = m_Vehicles.Get(keyId);
+		if (!vehicles)
+			return;
+
+		vehicles.RemoveItem(vehicle);
+		vehicles.RemoveItem(null);
+		if (vehicles.IsEmpty())
+			m_Vehicles.Remove(keyId);
+	}
+
+	/*!
+	    Record that a player just withdrew the vehicle with this key id.
+	*/
+	void RecordUse(string keyId, int playerId)
+	{
+		m_LastUsePlayer.Set(keyId, playerId);
+		m_LastUseTick.Set(keyId, System.GetTickCount());
+	}
+
+	/*!
+	    Tick of this player's last withdrawal of the vehicle, or 0 if the last
+	    withdrawal was by someone else (or never).
+	*/
+	int GetLastUseTick(string keyId, int playerId)
+	{
+		int lastPlayer;
+		if (!m_LastUsePlayer.Find(keyId, lastPlayer) || lastPlayer != playerId)
+			return 0;
+
+		return m_LastUseTick.Get(keyId);
+	}
+
+	/*!
+	    Append the live vehicles registered under a key id.
+	    \return Number of vehicles appended
+	*/
+	int FindAll(string keyId, notnull array<IEntity> outVehicles)
+	{
+		array<IEntity> vehicles = m_Vehicles.Get(keyId);
+		if (!vehicles)
+			return 0;
+
+		vehicles.RemoveItem(null);
+		if (vehicles.IsEmpty())
+		{
+			m_Vehicles.Remove(keyId);
+			return 0;
+		}
+
+		outVehicles.InsertAll(vehicles);
+		return vehicles.Count();
+	}
+}
+
+/*!
+    Key_LockComponent (modded)
+    -------------------------
+    Keeps BGL_VehicleKeyRegistry in sync with vehicle lock ids (server only).
+*/
+modded class Key_LockComponent
+{
+	protected string m_sBGL_RegisteredKeyId; //!< Id this vehicle is registered under ("" if none)
+
+	override void OnPostInit(IEntity owner)
+	{
+		super.OnPostInit(owner);
+		BGL_SyncRegistry();
+	}
+
+	override void SetID(string id, string keyId)
+	{
+		super.SetID(id, keyId);
+		BGL_SyncRegistry();
+	}
+
+	override void OnDelete(IEntity owner)
+	{
+		if (m_sBGL_RegisteredKeyId != "")
+			BGL_VehicleKeyRegistry.GetInstance().Unregister(m_sBGL_RegisteredKeyId, owner);
+
+		super.OnDelete(owner);
+	}
+
+	/*!
+	    Re-register the owner vehicle under its current myID.
+	*/
+	protected void BGL_SyncRegistry()
+	{
+		if (!Replication.IsServer())
+			return;
+
+		IEntity owner = GetOwner();
+		if (!owner || !owner.IsInherited(BaseVehicle))
+			return;
+
+		string keyId = myID;
+		if (keyId == m_sBGL_RegisteredKeyId)
+			return;
+
+		BGL_VehicleKeyRegistry registry = BGL_VehicleKeyRegistry.GetInstance();
+		if (m_sBGL_RegisteredKeyId != "")
+			registry.Unregister(m_sBGL_RegisteredKeyId, owner);
+
+		m_sBGL_RegisteredKeyId = keyId;
+		registry.Register(keyId, owner);
+	}
+}
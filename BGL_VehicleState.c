@@ -0,0 +1,61 @@
+/*!
+    BGL_VehicleState
+    ------------------------
+    Component state of a stored vehicle, captured at store time and applied
+    at withdrawal by the BGL_VehicleStateModule set (see BGL_VehicleStateRegistry).
+
+    Fields
+    - fuel:     Per fuel node, fill level in permille (FuelManagerComponent)
+    - hitzones: Per hitzone, scaled health in permille (DamageManagerComponent)
+    - ammo:     Per mounted weapon, rounds in its current magazine (0 = none)
+
+    Notes
+    - Lists follow the order the components report for the vehicle's prefab,
+      so entries are positional; a module skips a list whose length no longer
+      matches the spawned vehicle (prefab changed between store and withdraw).
+    - Empty lists mean "not captured": the module does not apply to this
+      vehicle, or it was stored before state capture existed.
+    - Integers only, so JSON and BGL_GarageBinaryCodec round-trip exactly.
+
+    Example JSON fragment:
+    {
+      "fuel": [ 640 ],
+      "hitzones": [ 1000, 875, 1000, 0 ],
+      "ammo": [ 120, 8 ]
+    }
+*/
+class BGL_VehicleState : JsonApiStruct
+{
+	static const float PERMILLE = 1000.0;
+
+	ref array<int> fuel;
+	ref array<int> hitzones;
+	ref array<int> ammo;
+
+	void BGL_VehicleState()
+	{
+		RegV("fuel");
+		RegV("hitzones");
+		RegV("ammo");
+		fuel = {};
+		hitzones = {};
+		ammo = {};
+	}
+
+	/*!
+	    Fraction (0..1) → permille, clamped.
+	*/
+	static int ToPermille(float fraction)
+	{
+		int permille = Math.Round(Math.Clamp(fraction, 0, 1) * PERMILLE);
+		return permille;
+	}
+
+	/*!
+	    Permille → fraction (0..1).
+	*/
+	static float FromPermille(int permille)
+	{
+		return permille / PERMILLE;
+	}
+}
@@ -0,0 +1,197 @@
+/*!
+    BGL_VehicleStateModule
+    -------------------------
+    One capture/apply step of the vehicle state pipeline. Subclasses each own
+    one component type and one typed list of BGL_VehicleState, and are
+    registered once in BGL_VehicleStateRegistry.
+
+    Contract
+    - Capture(): fill the module's list from the live vehicle; return false
+      (leaving the list empty) if the vehicle lacks the component. The
+      registry remembers the result per prefab and skips the module for
+      that prefab afterwards.
+    - HasState(): true if the stored state holds data for this module.
+    - Apply(): restore the list onto a freshly spawned vehicle.
+*/
+class BGL_VehicleStateModule
+{
+	bool Capture(IEntity vehicle, BGL_VehicleState state)
+	{
+		return false;
+	}
+
+	bool HasState(BGL_VehicleState state)
+	{
+		return false;
+	}
+
+	void Apply(IEntity vehicle, BGL_VehicleState state)
+	{
+	}
+}
+
+/*!
+    BGL_FuelStateModule
+    -------------------------
+    Fuel level of every fuel node (BGL_VehicleState.fuel).
+*/
+class BGL_FuelStateModule : BGL_VehicleStateModule
+{
+	override bool Capture(IEntity vehicle, BGL_VehicleState state)
+	{
+		FuelManagerComponent fuelManager = FuelManagerComponent.Cast(vehicle.FindComponent(FuelManagerComponent));
+		if (!fuelManager)
+			return false;
+
+		array<BaseFuelNode> nodes = {};
+		fuelManager.GetFuelNodesList(nodes);
+		foreach (BaseFuelNode node : nodes)
+		{
+			float maxFuel = node.GetMaxFuel();
+			if (maxFuel > 0)
+				state.fuel.Insert(BGL_VehicleState.ToPermille(node.GetFuel() / maxFuel));
+			else
+				state.fuel.Insert(0);
+		}
+
+		return true;
+	}
+
+	override bool HasState(BGL_VehicleState state)
+	{
+		return !state.fuel.IsEmpty();
+	}
+
+	override void Apply(IEntity vehicle, BGL_VehicleState state)
+	{
+		FuelManagerComponent fuelManager = FuelManagerComponent.Cast(vehicle.FindComponent(FuelManagerComponent));
+		if (!fuelManager)
+			return;
+
+		array<BaseFuelNode> nodes = {};
+		fuelManager.GetFuelNodesList(nodes);
+		if (nodes.Count() != state.fuel.Count())
+			return;
+
+		foreach (int i, BaseFuelNode node : nodes)
+		{
+			SCR_FuelNode fuelNode = SCR_FuelNode.Cast(node);
+			if (fuelNode)
+				fuelNode.SetFuel(node.GetMaxFuel() * BGL_VehicleState.FromPermille(state.fuel[i]));
+		}
+	}
+}
+
+/*!
+    BGL_HitZoneStateModule
+    -------------------------
+    Scaled health of every hitzone (BGL_VehicleState.hitzones).
+*/
+class BGL_HitZoneStateModule : BGL_VehicleStateModule
+{
+	override bool Capture(IEntity vehicle, BGL_VehicleState state)
+	{
+		DamageManagerComponent damageManager = DamageManagerComponent.Cast(vehicle.FindComponent(DamageManagerComponent));
+		if (!damageManager)
+			return false;
+
+		array<HitZone> hitZones = {};
+		damageManager.GetAllHitZones(hitZones);
+		foreach (HitZone hitZone : hitZones)
+		{
+			state.hitzones.Insert(BGL_VehicleState.ToPermille(hitZone.GetHealthScaled()));
+		}
+
+		return true;
+	}
+
+	override bool HasState(BGL_VehicleState state)
+	{
+		return !state.hitzones.IsEmpty();
+	}
+
+	override void Apply(IEntity vehicle, BGL_VehicleState state)
+	{
+		DamageManagerComponent damageManager = DamageManagerComponent.Cast(vehicle.FindComponent(DamageManagerComponent));
+		if (!damageManager)
+			return;
+
+		array<HitZone> hitZones = {};
+		damageManager.GetAllHitZones(hitZones);
+		if (hitZones.Count() != state.hitzones.Count())
+			return;
+
+		foreach (int i, HitZone hitZone : hitZones)
+		{
+			hitZone.SetHealthScaled(BGL_VehicleState.FromPermille(state.hitzones[i]));
+		}
+	}
+}
+
+/*!
+    BGL_AmmoStateModule
+    -------------------------
+    Rounds in the current magazine of every mounted weapon (turrets are child
+    entities of the vehicle) (BGL_VehicleState.ammo).
+*/
+class BGL_AmmoStateModule : BGL_VehicleStateModule
+{
+	override bool Capture(IEntity vehicle, BGL_VehicleState state)
+	{
+		array<BaseWeaponComponent> weapons = {};
+		CollectWeapons(vehicle, weapons);
+		if (weapons.IsEmpty())
+			return false;
+
+		foreach (BaseWeaponComponent weapon : weapons)
+		{
+			BaseMagazineComponent magazine = weapon.GetCurrentMagazine();
+			if (magazine)
+				state.ammo.Insert(magazine.GetAmmoCount());
+			else
+				state.ammo.Insert(0);
+		}
+
+		return true;
+	}
+
+	override bool HasState(BGL_VehicleState state)
+	{
+		return !state.ammo.IsEmpty();
+	}
+
+	override void Apply(IEntity vehicle, BGL_VehicleState state)
+	{
+		array<BaseWeaponComponent> weapons = {};
+		CollectWeapons(vehicle, weapons);
+		if (weapons.Count() != state.ammo.Count())
+			return;
+
+		foreach (int i, BaseWeaponComponent weapon : weapons)
+		{
+			BaseMagazineComponent magazine = weapon.GetCurrentMagazine();
+			if (magazine)
+				magazine.SetAmmoCount(state.ammo[i]);
+		}
+	}
+
+	/*!
+	    Depth-first walk of the vehicle hierarchy collecting weapon components.
+	*/
+	protected void CollectWeapons(IEntity entity, notnull array<BaseWeaponComponent> outWeapons)
+	{
+		array<Managed> components = {};
+		entity.FindComponents(BaseWeaponComponent, components);
+		foreach (Managed component : components)
+		{
+			outWeapons.Insert(BaseWeaponComponent.Cast(component));
+		}
+
+		IEntity child = entity.GetChildren();
+		while (child)
+		{
+			CollectWeapons(child, outWeapons);
+			child = child.GetSibling();
+		}
+	}
+}
@@ -0,0 +1,96 @@
+/*!
+    BGL_VehicleStateRegistry
+    -------------------------
+    Server-wide list of vehicle state modules (BGL_VehicleStateModule),
+    registered once when the registry is created.
+
+    Responsibilities
+    - Capture(): run the modules that apply to the vehicle's prefab at store time.
+    - Apply():   run the modules whose data is present at withdrawal (LoadCar).
+    - Remember per prefab which modules found their component, so later
+      captures of the same prefab skip the component lookups of modules that
+      do not apply.
+
+    Adding a module
+    - Subclass BGL_VehicleStateModule, add its typed list to BGL_VehicleState
+      (and to BGL_GarageBinaryCodec, bumping its version), and register it in
+      the constructor below. At most 31 modules (per-prefab bitmask).
+*/
+class BGL_VehicleStateRegistry
+{
+	protected static ref BGL_VehicleStateRegistry s_Instance;
+
+	protected ref array<ref BGL_VehicleStateModule> m_aModules = {};        //!< Registered modules, in apply order
+	protected ref map<ResourceName, int> m_PrefabModules = new map<ResourceName, int>(); //!< Prefab → bitmask of applicable modules
+
+	/*!
+	    Return the server-wide registry, creating it on first use.
+	*/
+	static BGL_VehicleStateRegistry GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_VehicleStateRegistry();
+
+		return s_Instance;
+	}
+
+	void BGL_VehicleStateRegistry()
+	{
+		Register(new BGL_FuelStateModule());
+		Register(new BGL_HitZoneStateModule());
+		Register(new BGL_AmmoStateModule());
+	}
+
+	/*!
+	    Add a module (call once per module type).
+	*/
+	void Register(notnull BGL_VehicleStateModule module)
+	{
+		m_aModules.Insert(module);
+		m_PrefabModules.Clear();
+	}
+
+	/*!
+	    Capture the live vehicle's component state into state.
+	    The first capture of a prefab tries every module; later ones only the
+	    modules that applied.
+	*/
+	void Capture(IEntity vehicle, notnull BGL_VehicleState state)
+	{
+		ResourceName prefab = vehicle.GetPrefabData().GetPrefabName();
+
+		int mask;
+		if (m_PrefabModules.Find(prefab, mask))
+		{
+			foreach (int i, BGL_VehicleStateModule module : m_aModules)
+			{
+				if (mask & (1 << i))
+					module.Capture(vehicle, state);
+			}
+			return;
+		}
+
+		foreach (int i, BGL_VehicleStateModule module : m_aModules)
+		{
+			if (module.Capture(vehicle, state))
+				mask |= 1 << i;
+		}
+
+		m_PrefabModules.Insert(prefab, mask);
+	}
+
+	/*!
+	    Apply stored state to a freshly spawned vehicle.
+	*/
+	void Apply(IEntity vehicle, BGL_VehicleState state)
+	{
+		if (!vehicle || !state)
+			return;
+
+		foreach (BGL_VehicleStateModule module : m_aModules)
+		{
+			if (module.HasState(state))
+				module.Apply(vehicle, state);
+		}
+	}
+}
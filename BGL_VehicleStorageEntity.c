@@ -2,7 +2,9 @@
     BGL_VehicleInventorySlot
     ------------------------
     Represents a single inventory entry for a stored vehicle.  
-    Each slot maps a prefab path → count (number of that item stored).
+    Tree node of the inventory snapshot (see BGL_InventorySnapshot): one item
+    with the storage and slot it sat in; parent points to its container.
+    Legacy entries (parent/storage/slot = -1) map a prefab path → count.
 
     Responsibilities
     - Provide serializable structure for vehicle inventory items.
@@ -11,7 +13,10 @@
     Example JSON fragment:
     {
       "prefab": "{...}Prefabs/Items/Fuel/FuelCan.et",
-      "count": 2
+      "count": 1,
+      "parent": -1,
+      "storage": 0,
+      "slot": 3
     }
 */
 class BGL_VehicleInventorySlot : JsonApiStruct
@@ -19,9 +24,18 @@ class BGL_VehicleInventorySlot : JsonApiStruct
 	//! Prefab path of the item stored (unique identifier).
 	string prefab;
 
-	//! Quantity of this item stored.
+	//! Quantity of this item stored (1 for tree nodes).
 	int count;
 
+	//! Index of the containing node in the inventory array (-1 = the vehicle).
+	int parent;
+
+	//! Storage index on the parent (-1 = legacy, placed by inventory search).
+	int storage;
+
+	//! Slot index inside that storage (-1 = any).
+	int slot;
+
 	/*!
 	    Constructor
 	    - Registers members for JSON serialization/deserialization.
@@ -30,6 +44,20 @@ class BGL_VehicleInventorySlot : JsonApiStruct
 	{
 		RegV("prefab");
 		RegV("count");
+		RegV("parent");
+		RegV("storage");
+		RegV("slot");
+		parent = -1;
+		storage = -1;
+		slot = -1;
+	}
+
+	/*!
+	    True if this entry records where the item was stored.
+	*/
+	bool IsPlaced()
+	{
+		return storage >= 0;
 	}
 }
 
@@ -39,28 +67,36 @@ class BGL_VehicleInventorySlot : JsonApiStruct
     ------------------------
     Represents the full saved state of a single vehicle in the player’s garage.  
     Includes:
+      - Stable id (unique within the player's garage, never reused)
       - Prefab path of the vehicle
-      - Vehicle’s inventory (serialized as array of slots)
+      - Vehicle’s inventory (pre-order item tree, see BGL_InventorySnapshot)
       - Key lock metadata (id and code)
+      - Component state: fuel, hitzone health, mounted weapon ammo (BGL_VehicleState)
 
     Responsibilities
     - Provide serializable structure for vehicles inside player garage data.
-    - Manage conversion between in-memory map<string,int> and JSON array slots.
+    - Manage conversion between map<string,int> and legacy slots, and keep
+      the item tree consistent when entries are removed (RemoveSlot).
     - Store key metadata for secure ownership transfer.
 
     Example JSON fragment:
     {
+      "id": 7,
       "prefab": "{...}Prefabs/Vehicles/Car/MyCar.et",
       "inventory": [
-        { "prefab": "{...}Prefabs/Items/Fuel/FuelCan.et", "count": 2 },
-        { "prefab": "{...}Prefabs/Items/Toolkit/Toolkit.et", "count": 1 }
+        { "prefab": "{...}Prefabs/Items/Backpack.et", "count": 1, "parent": -1, "storage": 0, "slot": 0 },
+        { "prefab": "{...}Prefabs/Items/Toolkit/Toolkit.et", "count": 1, "parent": 0, "storage": 0, "slot": 2 }
       ],
       "key_id": "1234-5678-90",
-      "key_code": "ABCD"
+      "key_code": "ABCD",
+      "state": { "fuel": [ 640 ], "hitzones": [ 1000, 875 ], "ammo": [] }
     }
 */
 class BGL_VehicleStorageEntity : JsonApiStruct
 {
+	//! Stable id within the player's garage (0 = not assigned yet; see BGL_PlayerGarageStorageEntity.AddVehicle).
+	int id;
+
 	//! Prefab path for the stored vehicle.
 	string prefab;
 
@@ -73,18 +109,24 @@ class BGL_VehicleStorageEntity : JsonApiStruct
 	//! Associated code for the vehicle’s key (PIN/lock code).
 	string key_code;
 
+	//! Component state captured at store time (see BGL_VehicleStateRegistry).
+	ref BGL_VehicleState state;
+
 	/*!
 	    Constructor
 	    - Registers members with JSON API.
-	    - Ensures `inventory` is always initialized.
+	    - Ensures `inventory` and `state` are always initialized.
 	*/
 	void BGL_VehicleStorageEntity()
 	{
+		RegV("id");
 		RegV("prefab");
 		RegV("inventory");
 		RegV("key_id");
 		RegV("key_code");
+		RegV("state");
 		inventory = new array<ref BGL_VehicleInventorySlot>();
+		state = new BGL_VehicleState();
 	}
 
 	/*!
@@ -106,7 +148,7 @@ class BGL_VehicleStorageEntity : JsonApiStruct
 	/*!
 	    Convert inventory slots back into a map<string,int>.
 
-	    \return Map of prefab → count pairs (for respawning into a vehicle).
+	    \return Map of prefab → total count pairs.
 	*/
 	ref map<string, int> ToMap() 
 	{
@@ -114,12 +156,83 @@ class BGL_VehicleStorageEntity : JsonApiStruct
 
 		foreach (BGL_VehicleInventorySlot slot : inventory)
 		{
-			itemsMap.Insert(slot.prefab, slot.count);
+			itemsMap.Set(slot.prefab, itemsMap.Get(slot.prefab) + slot.count);
 		}
 
 		return itemsMap;
 	}
-}
 
+	/*!
+	    Remove an entry and everything stored inside it, re-pointing the
+	    parent index of the entries that follow.
+	    \return Number of entries removed
+	*/
+	int RemoveSlot(int index)
+	{
+		int end = index + 1;
+		while (end < inventory.Count() && IsInside(end, index))
+		{
+			end++;
+		}
 
+		int removed = end - index;
+		for (int i = end - 1; i >= index; i--)
+		{
+			inventory.RemoveOrdered(i);
+		}
+
+		foreach (BGL_VehicleInventorySlot slot : inventory)
+		{
+			if (slot.parent >= end)
+				slot.parent = slot.parent - removed;
+		}
+
+		return removed;
+	}
+
+	/*!
+	    True if the entry at index lies (directly or nested) inside containerIndex.
+	*/
+	protected bool IsInside(int index, int containerIndex)
+	{
+		int parent = inventory[index].parent;
+		while (parent > containerIndex)
+		{
+			parent = inventory[parent].parent;
+		}
+
+		return parent == containerIndex;
+	}
+
+	/*!
+	    Fold legacy inventory slots that share a prefab into the first one.
+	    Placed entries (item tree) are left alone.
+	    \return Number of slots removed
+	*/
+	int MergeDuplicateSlots()
+	{
+		map<string, BGL_VehicleInventorySlot> firstSlots = new map<string, BGL_VehicleInventorySlot>();
+		int merged;
+
+		for (int i; i < inventory.Count(); i++)
+		{
+			BGL_VehicleInventorySlot slot = inventory[i];
+			if (slot.IsPlaced())
+				continue;
+
+			BGL_VehicleInventorySlot first;
+			if (!firstSlots.Find(slot.prefab, first))
+			{
+				firstSlots.Insert(slot.prefab, slot);
+				continue;
+			}
+
+			first.count += slot.count;
+			inventory.RemoveOrdered(i);
+			i--;
+			merged++;
+		}
+
+		return merged;
+	}
 }
@@ -0,0 +1,311 @@
+/*!
+    BGL_WithdrawalQueue
+    -------------------------
+    Server-wide queue for vehicle withdrawals from every garage.
+
+    Responsibilities
+    - Take LoadCar() requests off the RPC handler and spawn at most
+      m_iSpawnsPerFrame vehicles per frame across all garages, so a burst
+      (server restart, mission start) cannot stall a single frame.
+    - Serve requests by wait time: the list stays in first-queued order and
+      is scanned front to back each frame.
+    - Keep one request per player: a repeated request replaces the vehicle
+      but keeps the original place in the queue.
+    - Convoys (EnqueueConvoy): several requests of one player queued
+      together, each taking the first clear pad when its turn comes, with
+      one blocked notice per convoy and one summary once every vehicle is
+      handed over (OnConvoyVehicleDone) or dropped.
+    - Hold the vehicle's checkout lock (BGL_GarageCheckout) while a request
+      is queued, so two members of a pool cannot withdraw the same vehicle.
+    - Hold requests whose garage has every spawn pad blocked, re-checking
+      them every PAD_RETRY_MS while later requests for other garages proceed,
+      and tell those players their position among the garage's waiting requests.
+
+    Notes
+    - Server only. Configured by BGL_Component.OnPostInit (SetSpawnsPerFrame).
+    - Spawning itself is BGL_Component.TryWithdraw(); inventory restoration is
+      further spread over frames by the garage's rehydration jobs.
+*/
+class BGL_WithdrawalQueue
+{
+	static const int PAD_RETRY_MS = 1000; //!< Pad re-check interval for a blocked request
+
+	protected static ref BGL_WithdrawalQueue s_Instance;
+
+	protected ref array<ref BGL_WithdrawalRequest> m_aRequests = {}; //!< Pending requests (first-queued first)
+	protected int m_iSpawnsPerFrame = 1;                            //!< Spawn budget per frame
+	protected ref map<int, ref BGL_WithdrawalConvoy> m_Convoys = new map<int, ref BGL_WithdrawalConvoy>(); //!< Convoy id → progress
+	protected int m_iLastConvoyId;                                  //!< Last convoy id handed out
+
+	/*!
+	    Return the server-wide queue, creating it on first use.
+	*/
+	static BGL_WithdrawalQueue GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new BGL_WithdrawalQueue();
+
+		return s_Instance;
+	}
+
+	/*!
+	    Set the number of vehicles spawned per frame (server-wide, minimum 1).
+	*/
+	void SetSpawnsPerFrame(int spawnsPerFrame)
+	{
+		m_iSpawnsPerFrame = Math.Max(1, spawnsPerFrame);
+	}
+
+	/*!
+	    Queue a withdrawal (replacing the player's pending one, if any).
+	    \return false if another player has the vehicle checked out
+	*/
+	bool Enqueue(BGL_Component garage, string garageKey, BGL_VehicleStorageEntity vehData, int playerId)
+	{
+		BGL_GarageCheckout checkout = BGL_GarageCheckout.GetInstance();
+		if (!checkout.Acquire(garageKey, vehData.id, playerId))
+			return false;
+
+		bool wasEmpty = m_aRequests.IsEmpty();
+		BGL_WithdrawalRequest request;
+		foreach (BGL_WithdrawalRequest queued : m_aRequests)
+		{
+			if (queued.m_iPlayerId == playerId && queued.m_iConvoyId == 0)
+			{
+				request = queued;
+				break;
+			}
+		}
+
+		if (!request)
+		{
+			request = new BGL_WithdrawalRequest(garage, garageKey, playerId);
+			m_aRequests.Insert(request);
+			BGL_Metrics.Count("load_requests_total");
+		}
+		else
+		{
+			if (request.m_sGarageKey != garageKey || request.m_VehData.id != vehData.id)
+				checkout.Release(request.m_sGarageKey, request.m_VehData.id, playerId);
+
+			BGL_Metrics.Count("load_requests_deduped_total");
+		}
+
+		request.m_Garage = garage;
+		request.m_sGarageKey = garageKey;
+		request.m_VehData = vehData;
+		request.m_iNextRetryTick = 0;
+
+		// A replaced request means the queue was not empty, so Tick is already scheduled
+		if (wasEmpty)
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+
+		return true;
+	}
+
+	/*!
+	    Queue several withdrawals of one player as a convoy.
+	    Vehicles checked out by another player are counted as skipped.
+	    \param garageKeys Garage of each vehicle (parallel to vehicles)
+	    \param skipped    Vehicles the caller already refused (for the summary)
+	    \return Number of vehicles queued (0: nothing queued, no summary follows)
+	*/
+	int EnqueueConvoy(BGL_Component garage, notnull array<string> garageKeys, notnull array<BGL_VehicleStorageEntity> vehicles, int playerId, int skipped)
+	{
+		BGL_GarageCheckout checkout = BGL_GarageCheckout.GetInstance();
+		bool wasEmpty = m_aRequests.IsEmpty();
+		int convoyId = m_iLastConvoyId + 1;
+
+		BGL_WithdrawalConvoy convoy = new BGL_WithdrawalConvoy();
+		convoy.m_iPlayerId = playerId;
+		convoy.m_iSkipped = skipped;
+
+		foreach (int i, BGL_VehicleStorageEntity vehData : vehicles)
+		{
+			if (!checkout.Acquire(garageKeys[i], vehData.id, playerId))
+			{
+				convoy.m_iSkipped++;
+				continue;
+			}
+
+			BGL_WithdrawalRequest request = new BGL_WithdrawalRequest(garage, garageKeys[i], playerId);
+			request.m_VehData = vehData;
+			request.m_iConvoyId = convoyId;
+			m_aRequests.Insert(request);
+			convoy.m_iPending++;
+		}
+
+		if (convoy.m_iPending == 0)
+			return 0;
+
+		m_iLastConvoyId = convoyId;
+		m_Convoys.Insert(convoyId, convoy);
+		BGL_Metrics.Count("load_convoys_total");
+		BGL_Metrics.Observe("load_convoy_size", convoy.m_iPending);
+
+		if (wasEmpty)
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+
+		return convoy.m_iPending;
+	}
+
+	/*!
+	    A convoy vehicle left the pipeline: handed over (rehydrated) or lost.
+	    Sends the convoy summary after the last one.
+	*/
+	void OnConvoyVehicleDone(int convoyId, bool withdrawn)
+	{
+		BGL_WithdrawalConvoy convoy = m_Convoys.Get(convoyId);
+		if (!convoy)
+			return;
+
+		convoy.m_iPending--;
+		if (withdrawn)
+			convoy.m_iWithdrawn++;
+		else
+			convoy.m_iSkipped++;
+
+		if (convoy.m_iPending > 0)
+			return;
+
+		m_Convoys.Remove(convoyId);
+
+		string summary = string.Format("Convoy complete: %1 vehicles withdrawn.", convoy.m_iWithdrawn);
+		if (convoy.m_iSkipped > 0)
+			summary += string.Format(" %1 could not be withdrawn.", convoy.m_iSkipped);
+
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(convoy.m_iPlayerId));
+		if (playerController)
+			playerController.BGL_Server_RequestNotify("Garage", summary);
+	}
+
+	/*!
+	    Drop every request of a garage (garage teardown).
+	*/
+	void RemoveGarage(BGL_Component garage)
+	{
+		for (int i = m_aRequests.Count() - 1; i >= 0; i--)
+		{
+			if (m_aRequests[i].m_Garage == garage)
+				DropAt(i);
+		}
+	}
+
+	// =========================================================
+	// Internals
+	// =========================================================
+
+	/*!
+	    Per-frame tick: spawn up to m_iSpawnsPerFrame requests, oldest first.
+	    Stops itself when the queue is empty.
+	*/
+	protected void Tick()
+	{
+		int now = System.GetTickCount();
+		BGL_Metrics.Observe("load_queue_depth", m_aRequests.Count());
+
+		int spawned;
+		int i;
+		while (i < m_aRequests.Count() && spawned < m_iSpawnsPerFrame)
+		{
+			BGL_WithdrawalRequest request = m_aRequests[i];
+			if (request.m_iNextRetryTick > now)
+			{
+				i++;
+				continue;
+			}
+
+			if (!IsStillStored(request))
+			{
+				DropAt(i);
+				continue;
+			}
+
+			if (!request.m_Garage.TryWithdraw(request.m_sGarageKey, request.m_VehData, request.m_iPlayerId, request.m_iConvoyId))
+			{
+				request.m_iNextRetryTick = now + PAD_RETRY_MS;
+				NotifyBlocked(request, i);
+				i++;
+				continue;
+			}
+
+			BGL_Metrics.Lap("load_queue_wait_ms", request.m_iQueuedTick);
+			RemoveAt(i);
+			spawned++;
+		}
+
+		if (m_aRequests.IsEmpty())
+			GetGame().GetCallqueue().Remove(Tick);
+	}
+
+	/*!
+	    Drop a request and release its checkout lock.
+	*/
+	protected void RemoveAt(int index)
+	{
+		BGL_WithdrawalRequest request = m_aRequests[index];
+		BGL_GarageCheckout.GetInstance().Release(request.m_sGarageKey, request.m_VehData.id, request.m_iPlayerId);
+		m_aRequests.RemoveOrdered(index);
+	}
+
+	/*!
+	    Drop a request that will not be withdrawn (counted against its convoy).
+	*/
+	protected void DropAt(int index)
+	{
+		int convoyId = m_aRequests[index].m_iConvoyId;
+		RemoveAt(index);
+
+		if (convoyId > 0)
+			OnConvoyVehicleDone(convoyId, false);
+	}
+
+	/*!
+	    True if the request's garage still exists and its vehicle id is still
+	    stored (refreshes m_VehData to the current entry).
+	*/
+	protected bool IsStillStored(BGL_WithdrawalRequest request)
+	{
+		if (!request.m_Garage)
+			return false;
+
+		BGL_PlayerGarageStorageEntity storage = BGL_GarageCache.GetInstance().Get(request.m_sGarageKey);
+		if (!storage)
+			return false;
+
+		BGL_VehicleStorageEntity vehData = storage.FindVehicle(request.m_VehData.id);
+		if (!vehData)
+			return false;
+
+		request.m_VehData = vehData;
+		return true;
+	}
+
+	/*!
+	    Tell a pad-blocked player their position among the requests waiting on
+	    the same garage (only when it changed). A convoy is told once, for its
+	    first waiting vehicle.
+	*/
+	protected void NotifyBlocked(BGL_WithdrawalRequest request, int index)
+	{
+		int position = 1;
+		for (int i; i < index; i++)
+		{
+			BGL_WithdrawalRequest ahead = m_aRequests[i];
+			if (request.m_iConvoyId > 0 && ahead.m_iConvoyId == request.m_iConvoyId)
+				return;
+
+			if (ahead.m_Garage == request.m_Garage)
+				position++;
+		}
+
+		if (position == request.m_iNotifiedPosition)
+			return;
+
+		request.m_iNotifiedPosition = position;
+
+		SCR_PlayerController playerController = SCR_PlayerController.Cast(GetGame().GetPlayerManager().GetPlayerController(request.m_iPlayerId));
+		if (playerController)
+			playerController.BGL_Server_RequestNotify("Garage", string.Format("All spawn pads are busy. You are number %1 in the queue.", position));
+	}
+}
@@ -0,0 +1,49 @@
+/*!
+    BGL_WithdrawalRequest
+    -------------------------
+    One pending LoadCar() in the server-wide BGL_WithdrawalQueue.
+
+    Notes
+    - The vehicle is resolved by its stable id before spawning, so the
+      request stays valid while the garage changes; it is dropped if the
+      vehicle leaves the garage before it is processed.
+    - The garage key is the player's UID or a pool key (BGL_GaragePools);
+      the request holds the vehicle's BGL_GarageCheckout lock while queued.
+    - The garage reference is weak; requests of a deleted garage are dropped.
+    - Requests of a convoy (m_iConvoyId > 0) are not replaced by the
+      player's later requests; see BGL_WithdrawalConvoy.
+*/
+class BGL_WithdrawalRequest
+{
+	BGL_Component m_Garage;                 //!< Garage whose pads the vehicle spawns on
+	string m_sGarageKey;                    //!< Garage the vehicle is withdrawn from
+	int m_iPlayerId;                        //!< Requesting player (notifications)
+	ref BGL_VehicleStorageEntity m_VehData; //!< Entry to withdraw
+	int m_iQueuedTick;                      //!< Tick the request was first queued (priority)
+	int m_iNextRetryTick;                   //!< Earliest tick to re-check pads after a block
+	int m_iNotifiedPosition;                //!< Queue position last sent to the player (0 = none)
+	int m_iConvoyId;                        //!< Convoy the request belongs to (0 = single withdrawal)
+
+	void BGL_WithdrawalRequest(BGL_Component garage, string garageKey, int playerId)
+	{
+		m_Garage = garage;
+		m_sGarageKey = garageKey;
+		m_iPlayerId = playerId;
+		m_iQueuedTick = System.GetTickCount();
+	}
+}
+
+/*!
+    BGL_WithdrawalConvoy
+    -------------------------
+    Progress of a convoy withdrawal (BGL_Component.WithdrawConvoy): several
+    vehicles queued at once for one player, reported with a single summary
+    notification once every vehicle has been handed over or dropped.
+*/
+class BGL_WithdrawalConvoy
+{
+	int m_iPlayerId;  //!< Requesting player
+	int m_iPending;   //!< Vehicles queued or still rehydrating
+	int m_iWithdrawn; //!< Vehicles handed over
+	int m_iSkipped;   //!< Vehicles that could not be withdrawn
+}
@@ -1,23 +1,36 @@
 /*!
     SCR_PlayerController (modded)
     -----------------------------
-    Extended with BGL (Boogie’s Garage & Logistics) RPCs and helpers.  
+    Extended with BGL (Boogie’s Garage & Logistics) RPCs and helpers.
     Provides client ↔ server communication for garage interactions:
       - Opening the garage UI
       - Requesting vehicle load
-      - Saving updated storage
+      - Deleting a stored vehicle (server-authoritative, by id)
       - Sending custom notifications
 
     Key Flow:
       1) Player interacts with a garage sign → server calls BGL_OpenMenu()
-      2) Storage is serialized and sent to the client
-      3) Client UI opens (BGL_UIClass), showing available vehicles
-      4) UI actions (spawn/delete) trigger client requests back to server
-      5) Server executes storage or spawn logic in BGL_Component
-      6) Notifications are sent back to the player
+      2) Server sends one BGL_GarageDelta per garage the player can open at
+         the sign (personal, then faction/group pools), each against the
+         revision it last sent for that garage (nothing, a diff, or a full
+         summary list)
+      3) Client applies them to its cached BGL_GarageSummary per garage and
+         opens the UI
+      4) Selecting a vehicle fetches its full entry on demand
+         (BGL_Client_RequestVehicleDetails → BGL_RPC_VehicleDetails)
+      5) UI actions (spawn/delete/details) address vehicles by garage key and
+         stable id (BGL_VehicleStorageEntity.id), so they stay correct while
+         a garage changes elsewhere (another sign, another pool member)
+      6) Server checks the garage key against the garages it listed for this
+         player, then executes the op in BGL_Component/cache
+      7) Notifications are sent back to the player
 
     Notes:
-      - All RPCs use reliable channels for consistency.
+      - All RPCs use reliable channels for consistency; the server can
+        therefore assume the client holds whatever revision it last sent.
+      - A delete also carries the client's revision; if the server's garage
+        moved on meanwhile, the server's view of that garage is reset and the
+        next open (or an explicit resync request) sends a full summary list.
       - Server-only and owner-only receivers ensure correct flow.
 */
 modded class SCR_PlayerController
@@ -25,6 +38,21 @@ modded class SCR_PlayerController
 	//! Reference to the active BGL_Component for this session (garage logic).
 	BGL_Component m_bgl;
 
+	//! Server: UID of the player whose garages were last opened.
+	protected string m_sBGL_PlayerUid;
+
+	//! Server: garage keys listed in the last opened menu (access check for requests).
+	protected ref array<string> m_aBGL_Garages = {};
+
+	//! Server: storage revision last sent to this client, per garage key (missing = none).
+	protected ref map<string, int> m_BGL_SentRevisions = new map<string, int>();
+
+	//! Client: cached summary per garage key at a known revision.
+	protected ref map<string, ref BGL_GarageSummary> m_BGL_ClientGarages = new map<string, ref BGL_GarageSummary>();
+
+	//! Client: the open garage menu (receives vehicle details).
+	protected BGL_UIClass m_BGL_Menu;
+
 	// =========================================================
 	// Public entry points (called by server or client code)
 	// =========================================================
@@ -33,15 +61,16 @@ modded class SCR_PlayerController
 	    Request to open the garage menu for a player.
 
 	    Flow:
-	      - Server packs player storage
-	      - Calls RPC to client with signId, playerUid, and storage data
+	      - Server lists the garages the player can open here
+	        (BGL_Component.GetAccessibleGarages)
+	      - Builds a delta per garage from the revision last sent to this client
+	      - Calls RPC to client with signId, playerUid, and the packed payload
 
 	    \param signId   EntityID of the garage sign/terminal
 	    \param bgl      Reference to the BGL component attached to the sign
 	    \param playerUid Persistent UID of the player
-	    \param storage  Player’s garage storage payload
 	*/
-	void BGL_OpenMenu(EntityID signId, BGL_Component bgl, string playerUid, BGL_PlayerGarageStorageEntity storage)
+	void BGL_OpenMenu(EntityID signId, BGL_Component bgl, string playerUid)
 	{
 		// Ensure only server executes
 		if (!Replication.IsServer())
@@ -49,27 +78,92 @@ modded class SCR_PlayerController
 
 		m_bgl = bgl;
 
-		storage.Pack();
-		Rpc(BGL_RPC_OpenMenu, signId, playerUid, storage.AsString());
+		// A different player's garages (or none yet) means the client cache is unrelated
+		if (m_sBGL_PlayerUid != playerUid)
+			m_BGL_SentRevisions.Clear();
+
+		m_sBGL_PlayerUid = playerUid;
+
+		m_aBGL_Garages.Clear();
+		bgl.GetAccessibleGarages(GetPlayerId(), playerUid, m_aBGL_Garages);
+
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+		BGL_GarageMenuPayload payload = new BGL_GarageMenuPayload();
+		foreach (string garageKey : m_aBGL_Garages)
+		{
+			int sentRevision = -1;
+			if (!m_BGL_SentRevisions.Find(garageKey, sentRevision))
+				sentRevision = -1;
+
+			BGL_GarageDelta delta = cache.BuildDelta(garageKey, sentRevision);
+			if (!delta)
+				continue;
+
+			m_BGL_SentRevisions.Set(garageKey, delta.revision);
+			payload.garages.Insert(delta);
+		}
+
+		if (payload.garages.IsEmpty())
+			return;
+
+		payload.Pack();
+		string payloadString = payload.AsString();
+		BGL_Metrics.Observe("rpc_open_menu_bytes", payloadString.Length());
+		Rpc(BGL_RPC_OpenMenu, signId, playerUid, payloadString);
 	}
 
 	/*!
 	    Client request → Server: Load (spawn) a stored car.
-	    Sends playerUid + selection index.
+	    Sends garage key + vehicle id.
 	*/
-	void BGL_Client_RequestLoadCar(string playerUid, int vehSelected)
+	void BGL_Client_RequestLoadCar(string garageKey, int vehicleId)
 	{
-		Rpc(BGL_RPC_LoadCar, playerUid, vehSelected, GetPlayerId());
+		Rpc(BGL_RPC_LoadCar, garageKey, vehicleId);
 	}
 
 	/*!
-	    Client request → Server: Save the player’s garage storage.
-	    Packs storage and sends to server for persistence.
+	    Client request → Server: Withdraw several stored cars as a convoy.
+	    Sends the garage key of each vehicle alongside its id.
 	*/
-	void BGL_Client_RequestSavePlayerStorage(BGL_PlayerGarageStorageEntity storage)
+	void BGL_Client_RequestConvoy(array<string> garageKeys, array<int> vehicleIds)
 	{
-		storage.Pack();
-		Rpc(BGL_RPC_SavePlayerStorage, storage.AsString());
+		Rpc(BGL_RPC_Convoy, garageKeys, vehicleIds);
+	}
+
+	/*!
+	    Client request → Server: Delete a stored car.
+	    Applies the delete to the cached summary immediately and sends only
+	    the (garage key, vehicle id, revision) operation.
+	*/
+	void BGL_Client_RequestDeleteVehicle(string garageKey, int vehicleId)
+	{
+		BGL_GarageSummary garage = m_BGL_ClientGarages.Get(garageKey);
+		if (!garage)
+			return;
+
+		int revision = garage.revision;
+		if (!garage.ApplyOp(EBGL_JournalOp.DELETE, vehicleId, null))
+			return;
+
+		Rpc(BGL_RPC_DeleteVehicle, garageKey, vehicleId, revision);
+	}
+
+	/*!
+	    Client request → Server: Fetch the full entry (inventory + key) of one
+	    stored vehicle for the details panel.
+	*/
+	void BGL_Client_RequestVehicleDetails(string garageKey, int vehicleId)
+	{
+		Rpc(BGL_RPC_RequestVehicleDetails, garageKey, vehicleId);
+	}
+
+	/*!
+	    Client accessor for the cached summary of one garage (menu data source).
+	    \return Summary, or null if nothing was received for this garage
+	*/
+	BGL_GarageSummary BGL_GetClientGarage(string garageKey)
+	{
+		return m_BGL_ClientGarages.Get(garageKey);
 	}
 
 	/*!
@@ -90,50 +184,187 @@ modded class SCR_PlayerController
 	    Called by server via BGL_OpenMenu().
 
 	    Flow:
+	      - Apply each garage's delta to its cached summary
+	        (on a revision mismatch, ask the server for a full resync and stop)
 	      - Resolve the sign entity
 	      - Open BGL UI menu (ChimeraMenuPreset.BGLMenu)
-	      - Inject BGL_Component, playerUid, and storage string
+	      - Inject BGL_Component, playerUid, and the listed summaries
 	      - Populate the UI
 	*/
 	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
-	protected void BGL_RPC_OpenMenu(EntityID signId, string playerUid, string storageString)
+	protected void BGL_RPC_OpenMenu(EntityID signId, string playerUid, string payloadString)
 	{
+		BGL_GarageMenuPayload payload = new BGL_GarageMenuPayload();
+		payload.ExpandFromRAW(payloadString);
+
+		array<BGL_GarageSummary> garages = {};
+		foreach (BGL_GarageDelta delta : payload.garages)
+		{
+			BGL_GarageSummary garage = m_BGL_ClientGarages.Get(delta.garage_key);
+			if (!garage)
+			{
+				garage = new BGL_GarageSummary();
+				garage.garageKey = delta.garage_key;
+				m_BGL_ClientGarages.Insert(delta.garage_key, garage);
+			}
+
+			if (!garage.ApplyDelta(delta))
+			{
+				Rpc(BGL_RPC_RequestFullSync, signId);
+				return;
+			}
+
+			garages.Insert(garage);
+		}
+
 		IEntity sign = GetGame().GetWorld().FindEntityByID(signId);
 		BGL_UIClass bgl_uiclass = BGL_UIClass.Cast(GetGame().GetMenuManager().OpenMenu(ChimeraMenuPreset.BGLMenu));
 		BGL_Component bgl = BGL_Component.Cast(sign.FindComponent(BGL_Component));
 
 		bgl_uiclass.SetBGLComponent(bgl);
 		bgl_uiclass.SetPlayerUid(playerUid);
-		bgl_uiclass.SetPlayerStorage(storageString);
+		bgl_uiclass.SetGarages(garages);
 		bgl_uiclass.Main();
+		m_BGL_Menu = bgl_uiclass;
+	}
+
+	/*!
+	    RPC: Server-side handler for a client whose cache could not apply a delta.
+	    Forgets the sent revisions and re-sends the menu as full summary lists.
+	*/
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void BGL_RPC_RequestFullSync(EntityID signId)
+	{
+		m_BGL_SentRevisions.Clear();
+		BGL_OpenMenu(signId, m_bgl, m_sBGL_PlayerUid);
 	}
 
 	/*!
 	    RPC: Server-side handler for loading a vehicle.
-	    Calls into BGL_Component.LoadCar().
+	    Calls into BGL_Component.LoadCar() for a garage listed in the last
+	    opened menu (unknown ids are ignored there).
 
-	    \param playerUid  Persistent UID
-	    \param vehSelected Index of stored vehicle
-	    \param playerId   Runtime player id
+	    \param garageKey  Garage holding the vehicle (player UID or pool key)
+	    \param vehicleId  Id of the stored vehicle
 	*/
 	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
-	protected void BGL_RPC_LoadCar(string playerUid, int vehSelected, int playerId)
+	protected void BGL_RPC_LoadCar(string garageKey, int vehicleId)
 	{
-		m_bgl.LoadCar(playerUid, vehSelected, playerId);
+		if (!m_bgl || !m_aBGL_Garages.Contains(garageKey))
+			return;
+
+		m_bgl.LoadCar(garageKey, vehicleId, GetPlayerId());
 	}
 
 	/*!
-	    RPC: Server-side handler for saving player storage.
-	    Expands storage string and saves via BGL_Component.
+	    RPC: Server-side handler for a convoy withdrawal.
+	    Keeps the vehicles of garages listed in the last opened menu and calls
+	    BGL_Component.WithdrawConvoy(), which answers with one summary.
 
-	    \param playerStorage Packed storage string (JSON)
+	    \param garageKeys Garage of each vehicle (player UID or pool key)
+	    \param vehicleIds Ids of the stored vehicles, parallel to garageKeys
 	*/
 	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
-	protected void BGL_RPC_SavePlayerStorage(string playerStorage)
+	protected void BGL_RPC_Convoy(array<string> garageKeys, array<int> vehicleIds)
 	{
-		BGL_PlayerGarageStorageEntity storage = new BGL_PlayerGarageStorageEntity();
-		storage.ExpandFromRAW(playerStorage);
-		m_bgl.SavePlayerGarageData(storage);
+		if (!m_bgl || !garageKeys || !vehicleIds || garageKeys.Count() != vehicleIds.Count())
+			return;
+
+		array<string> keys = {};
+		array<int> ids = {};
+		foreach (int i, string garageKey : garageKeys)
+		{
+			if (!m_aBGL_Garages.Contains(garageKey))
+				continue;
+
+			keys.Insert(garageKey);
+			ids.Insert(vehicleIds[i]);
+		}
+
+		if (!ids.IsEmpty())
+			m_bgl.WithdrawConvoy(keys, ids, GetPlayerId());
+	}
+
+	/*!
+	    RPC: Server-side handler for deleting a stored vehicle.
+	    Applies the delete through BGL_Component.DeleteVehicle() on the
+	    server's copy of a garage listed in the last opened menu. The client
+	    already applied it locally: if both started from the same revision the
+	    sent revision simply advances with the server's, otherwise the next
+	    open resyncs that garage. A refused delete (syncing garage, checkout
+	    lock, unknown id) also resyncs it and tells the player, whose list
+	    no longer shows the vehicle.
+
+	    \param garageKey Garage holding the vehicle (player UID or pool key)
+	    \param vehicleId Id of the stored vehicle
+	    \param revision  Client revision the delete was applied on
+	*/
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void BGL_RPC_DeleteVehicle(string garageKey, int vehicleId, int revision)
+	{
+		if (!m_bgl || !m_aBGL_Garages.Contains(garageKey))
+			return;
+
+		BGL_GarageCache cache = BGL_GarageCache.GetInstance();
+		BGL_PlayerGarageStorageEntity storage = cache.Get(garageKey);
+		bool inSync = storage && storage.revision == revision;
+		if (!storage || !m_bgl.DeleteVehicle(garageKey, vehicleId, GetPlayerId()))
+		{
+			m_BGL_SentRevisions.Remove(garageKey);
+			BGL_Server_RequestNotify("Garage", "The vehicle could not be deleted. Reopen the garage to refresh the list.");
+			return;
+		}
+
+		if (!inSync)
+		{
+			m_BGL_SentRevisions.Remove(garageKey);
+			return;
+		}
+
+		m_BGL_SentRevisions.Set(garageKey, cache.Get(garageKey).revision);
+	}
+
+	/*!
+	    RPC: Server-side handler for a vehicle details request.
+	    Unknown ids (vehicle already gone) are ignored silently (the menu keeps
+	    its placeholder).
+
+	    \param garageKey Garage holding the vehicle (player UID or pool key)
+	    \param vehicleId Id of the stored vehicle
+	*/
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void BGL_RPC_RequestVehicleDetails(string garageKey, int vehicleId)
+	{
+		if (!m_aBGL_Garages.Contains(garageKey))
+			return;
+
+		BGL_PlayerGarageStorageEntity storage = BGL_GarageCache.GetInstance().Get(garageKey);
+		if (!storage)
+			return;
+
+		BGL_VehicleStorageEntity vehicle = storage.FindVehicle(vehicleId);
+		if (!vehicle)
+			return;
+
+		vehicle.Pack();
+		string vehicleString = vehicle.AsString();
+		BGL_Metrics.Observe("rpc_vehicle_details_bytes", vehicleString.Length());
+		Rpc(BGL_RPC_VehicleDetails, garageKey, vehicleId, vehicleString);
+	}
+
+	/*!
+	    RPC: Client-side handler for a vehicle details reply.
+	    Forwards to the open menu.
+	*/
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void BGL_RPC_VehicleDetails(string garageKey, int vehicleId, string vehicleString)
+	{
+		if (!m_BGL_Menu)
+			return;
+
+		BGL_VehicleStorageEntity vehicle = new BGL_VehicleStorageEntity();
+		vehicle.ExpandFromRAW(vehicleString);
+		m_BGL_Menu.SetVehicleDetails(garageKey, vehicleId, vehicle);
 	}
 
 	/*!